@@ -0,0 +1,79 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/dataserver/common/array.cpp" "CMakeFiles/dataserver.dir/dataserver/common/array.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/common/array.cpp.o.d"
+  "/root/repo/dataserver/common/compact_set.cpp" "CMakeFiles/dataserver.dir/dataserver/common/compact_set.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/common/compact_set.cpp.o.d"
+  "/root/repo/dataserver/common/config.cpp" "CMakeFiles/dataserver.dir/dataserver/common/config.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/common/config.cpp.o.d"
+  "/root/repo/dataserver/common/static.cpp" "CMakeFiles/dataserver.dir/dataserver/common/static.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/common/static.cpp.o.d"
+  "/root/repo/dataserver/common/test_ci.cpp" "CMakeFiles/dataserver.dir/dataserver/common/test_ci.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/common/test_ci.cpp.o.d"
+  "/root/repo/dataserver/common/time_util.cpp" "CMakeFiles/dataserver.dir/dataserver/common/time_util.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/common/time_util.cpp.o.d"
+  "/root/repo/dataserver/filesys/file_h.cpp" "CMakeFiles/dataserver.dir/dataserver/filesys/file_h.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/filesys/file_h.cpp.o.d"
+  "/root/repo/dataserver/filesys/file_map.cpp" "CMakeFiles/dataserver.dir/dataserver/filesys/file_map.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/filesys/file_map.cpp.o.d"
+  "/root/repo/dataserver/filesys/file_map_unix.cpp" "CMakeFiles/dataserver.dir/dataserver/filesys/file_map_unix.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/filesys/file_map_unix.cpp.o.d"
+  "/root/repo/dataserver/filesys/file_map_win32.cpp" "CMakeFiles/dataserver.dir/dataserver/filesys/file_map_win32.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/filesys/file_map_win32.cpp.o.d"
+  "/root/repo/dataserver/filesys/file_read.cpp" "CMakeFiles/dataserver.dir/dataserver/filesys/file_read.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/filesys/file_read.cpp.o.d"
+  "/root/repo/dataserver/filesys/window_map.cpp" "CMakeFiles/dataserver.dir/dataserver/filesys/window_map.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/filesys/window_map.cpp.o.d"
+  "/root/repo/dataserver/maketable/export_database.cpp" "CMakeFiles/dataserver.dir/dataserver/maketable/export_database.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/maketable/export_database.cpp.o.d"
+  "/root/repo/dataserver/maketable/generator.cpp" "CMakeFiles/dataserver.dir/dataserver/maketable/generator.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/maketable/generator.cpp.o.d"
+  "/root/repo/dataserver/maketable/generator_util.cpp" "CMakeFiles/dataserver.dir/dataserver/maketable/generator_util.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/maketable/generator_util.cpp.o.d"
+  "/root/repo/dataserver/maketable/maketable.cpp" "CMakeFiles/dataserver.dir/dataserver/maketable/maketable.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/maketable/maketable.cpp.o.d"
+  "/root/repo/dataserver/maketable/maketable_meta.cpp" "CMakeFiles/dataserver.dir/dataserver/maketable/maketable_meta.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/maketable/maketable_meta.cpp.o.d"
+  "/root/repo/dataserver/spatial/geo_data.cpp" "CMakeFiles/dataserver.dir/dataserver/spatial/geo_data.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/spatial/geo_data.cpp.o.d"
+  "/root/repo/dataserver/spatial/geography.cpp" "CMakeFiles/dataserver.dir/dataserver/spatial/geography.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/spatial/geography.cpp.o.d"
+  "/root/repo/dataserver/spatial/geography_info.cpp" "CMakeFiles/dataserver.dir/dataserver/spatial/geography_info.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/spatial/geography_info.cpp.o.d"
+  "/root/repo/dataserver/spatial/interval_cell.cpp" "CMakeFiles/dataserver.dir/dataserver/spatial/interval_cell.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/spatial/interval_cell.cpp.o.d"
+  "/root/repo/dataserver/spatial/interval_set.cpp" "CMakeFiles/dataserver.dir/dataserver/spatial/interval_set.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/spatial/interval_set.cpp.o.d"
+  "/root/repo/dataserver/spatial/math_util.cpp" "CMakeFiles/dataserver.dir/dataserver/spatial/math_util.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/spatial/math_util.cpp.o.d"
+  "/root/repo/dataserver/spatial/spatial_index.cpp" "CMakeFiles/dataserver.dir/dataserver/spatial/spatial_index.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/spatial/spatial_index.cpp.o.d"
+  "/root/repo/dataserver/spatial/spatial_type.cpp" "CMakeFiles/dataserver.dir/dataserver/spatial/spatial_type.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/spatial/spatial_type.cpp.o.d"
+  "/root/repo/dataserver/spatial/transform.cpp" "CMakeFiles/dataserver.dir/dataserver/spatial/transform.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/spatial/transform.cpp.o.d"
+  "/root/repo/dataserver/sysobj/boot_page.cpp" "CMakeFiles/dataserver.dir/dataserver/sysobj/boot_page.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/sysobj/boot_page.cpp.o.d"
+  "/root/repo/dataserver/sysobj/file_header.cpp" "CMakeFiles/dataserver.dir/dataserver/sysobj/file_header.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/sysobj/file_header.cpp.o.d"
+  "/root/repo/dataserver/sysobj/iam_page.cpp" "CMakeFiles/dataserver.dir/dataserver/sysobj/iam_page.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/sysobj/iam_page.cpp.o.d"
+  "/root/repo/dataserver/sysobj/iam_page_row.cpp" "CMakeFiles/dataserver.dir/dataserver/sysobj/iam_page_row.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/sysobj/iam_page_row.cpp.o.d"
+  "/root/repo/dataserver/sysobj/pfs_page.cpp" "CMakeFiles/dataserver.dir/dataserver/sysobj/pfs_page.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/sysobj/pfs_page.cpp.o.d"
+  "/root/repo/dataserver/sysobj/sysallocunits.cpp" "CMakeFiles/dataserver.dir/dataserver/sysobj/sysallocunits.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/sysobj/sysallocunits.cpp.o.d"
+  "/root/repo/dataserver/sysobj/syscolpars.cpp" "CMakeFiles/dataserver.dir/dataserver/sysobj/syscolpars.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/sysobj/syscolpars.cpp.o.d"
+  "/root/repo/dataserver/sysobj/sysidxstats.cpp" "CMakeFiles/dataserver.dir/dataserver/sysobj/sysidxstats.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/sysobj/sysidxstats.cpp.o.d"
+  "/root/repo/dataserver/sysobj/sysiscols.cpp" "CMakeFiles/dataserver.dir/dataserver/sysobj/sysiscols.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/sysobj/sysiscols.cpp.o.d"
+  "/root/repo/dataserver/sysobj/sysobjvalues.cpp" "CMakeFiles/dataserver.dir/dataserver/sysobj/sysobjvalues.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/sysobj/sysobjvalues.cpp.o.d"
+  "/root/repo/dataserver/sysobj/sysrowsets.cpp" "CMakeFiles/dataserver.dir/dataserver/sysobj/sysrowsets.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/sysobj/sysrowsets.cpp.o.d"
+  "/root/repo/dataserver/sysobj/sysscalartypes.cpp" "CMakeFiles/dataserver.dir/dataserver/sysobj/sysscalartypes.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/sysobj/sysscalartypes.cpp.o.d"
+  "/root/repo/dataserver/sysobj/sysschobjs.cpp" "CMakeFiles/dataserver.dir/dataserver/sysobj/sysschobjs.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/sysobj/sysschobjs.cpp.o.d"
+  "/root/repo/dataserver/system/catalog_sidecar.cpp" "CMakeFiles/dataserver.dir/dataserver/system/catalog_sidecar.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/system/catalog_sidecar.cpp.o.d"
+  "/root/repo/dataserver/system/database.cpp" "CMakeFiles/dataserver.dir/dataserver/system/database.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/system/database.cpp.o.d"
+  "/root/repo/dataserver/system/database_handle.cpp" "CMakeFiles/dataserver.dir/dataserver/system/database_handle.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/system/database_handle.cpp.o.d"
+  "/root/repo/dataserver/system/datapage.cpp" "CMakeFiles/dataserver.dir/dataserver/system/datapage.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/system/datapage.cpp.o.d"
+  "/root/repo/dataserver/system/datatable.cpp" "CMakeFiles/dataserver.dir/dataserver/system/datatable.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/system/datatable.cpp.o.d"
+  "/root/repo/dataserver/system/index_cache.cpp" "CMakeFiles/dataserver.dir/dataserver/system/index_cache.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/system/index_cache.cpp.o.d"
+  "/root/repo/dataserver/system/index_page.cpp" "CMakeFiles/dataserver.dir/dataserver/system/index_page.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/system/index_page.cpp.o.d"
+  "/root/repo/dataserver/system/index_tree.cpp" "CMakeFiles/dataserver.dir/dataserver/system/index_tree.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/system/index_tree.cpp.o.d"
+  "/root/repo/dataserver/system/key_compare.cpp" "CMakeFiles/dataserver.dir/dataserver/system/key_compare.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/system/key_compare.cpp.o.d"
+  "/root/repo/dataserver/system/key_filter.cpp" "CMakeFiles/dataserver.dir/dataserver/system/key_filter.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/system/key_filter.cpp.o.d"
+  "/root/repo/dataserver/system/nonclustered_index.cpp" "CMakeFiles/dataserver.dir/dataserver/system/nonclustered_index.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/system/nonclustered_index.cpp.o.d"
+  "/root/repo/dataserver/system/overflow.cpp" "CMakeFiles/dataserver.dir/dataserver/system/overflow.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/system/overflow.cpp.o.d"
+  "/root/repo/dataserver/system/page_head.cpp" "CMakeFiles/dataserver.dir/dataserver/system/page_head.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/system/page_head.cpp.o.d"
+  "/root/repo/dataserver/system/page_heatmap.cpp" "CMakeFiles/dataserver.dir/dataserver/system/page_heatmap.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/system/page_heatmap.cpp.o.d"
+  "/root/repo/dataserver/system/page_info.cpp" "CMakeFiles/dataserver.dir/dataserver/system/page_info.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/system/page_info.cpp.o.d"
+  "/root/repo/dataserver/system/page_map.cpp" "CMakeFiles/dataserver.dir/dataserver/system/page_map.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/system/page_map.cpp.o.d"
+  "/root/repo/dataserver/system/page_pool.cpp" "CMakeFiles/dataserver.dir/dataserver/system/page_pool.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/system/page_pool.cpp.o.d"
+  "/root/repo/dataserver/system/page_prefetch.cpp" "CMakeFiles/dataserver.dir/dataserver/system/page_prefetch.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/system/page_prefetch.cpp.o.d"
+  "/root/repo/dataserver/system/page_type.cpp" "CMakeFiles/dataserver.dir/dataserver/system/page_type.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/system/page_type.cpp.o.d"
+  "/root/repo/dataserver/system/pfs_bitmap.cpp" "CMakeFiles/dataserver.dir/dataserver/system/pfs_bitmap.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/system/pfs_bitmap.cpp.o.d"
+  "/root/repo/dataserver/system/primary_key.cpp" "CMakeFiles/dataserver.dir/dataserver/system/primary_key.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/system/primary_key.cpp.o.d"
+  "/root/repo/dataserver/system/usertable.cpp" "CMakeFiles/dataserver.dir/dataserver/system/usertable.cpp.o" "gcc" "CMakeFiles/dataserver.dir/dataserver/system/usertable.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
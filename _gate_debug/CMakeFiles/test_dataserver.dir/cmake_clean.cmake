@@ -0,0 +1,133 @@
+file(REMOVE_RECURSE
+  "/root/repo/bin/test_dataserver"
+  "/root/repo/bin/test_dataserver.pdb"
+  "CMakeFiles/test_dataserver.dir/dataserver/common/array.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/common/array.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/common/compact_set.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/common/compact_set.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/common/config.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/common/config.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/common/static.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/common/static.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/common/test_ci.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/common/test_ci.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/common/time_util.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/common/time_util.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/filesys/file_h.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/filesys/file_h.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/filesys/file_map.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/filesys/file_map.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/filesys/file_map_unix.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/filesys/file_map_unix.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/filesys/file_map_win32.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/filesys/file_map_win32.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/filesys/file_read.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/filesys/file_read.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/filesys/window_map.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/filesys/window_map.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/maketable/export_database.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/maketable/export_database.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/maketable/generator.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/maketable/generator.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/maketable/generator_util.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/maketable/generator_util.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/maketable/maketable.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/maketable/maketable.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/maketable/maketable_meta.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/maketable/maketable_meta.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/software/main.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/software/main.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/spatial/geo_data.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/spatial/geo_data.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/spatial/geography.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/spatial/geography.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/spatial/geography_info.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/spatial/geography_info.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/spatial/interval_cell.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/spatial/interval_cell.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/spatial/interval_set.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/spatial/interval_set.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/spatial/math_util.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/spatial/math_util.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/spatial/spatial_index.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/spatial/spatial_index.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/spatial/spatial_type.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/spatial/spatial_type.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/spatial/transform.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/spatial/transform.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/sysobj/boot_page.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/sysobj/boot_page.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/sysobj/file_header.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/sysobj/file_header.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/sysobj/iam_page.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/sysobj/iam_page.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/sysobj/iam_page_row.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/sysobj/iam_page_row.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/sysobj/pfs_page.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/sysobj/pfs_page.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/sysobj/sysallocunits.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/sysobj/sysallocunits.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/sysobj/syscolpars.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/sysobj/syscolpars.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/sysobj/sysidxstats.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/sysobj/sysidxstats.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/sysobj/sysiscols.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/sysobj/sysiscols.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/sysobj/sysobjvalues.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/sysobj/sysobjvalues.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/sysobj/sysrowsets.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/sysobj/sysrowsets.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/sysobj/sysscalartypes.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/sysobj/sysscalartypes.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/sysobj/sysschobjs.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/sysobj/sysschobjs.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/system/catalog_sidecar.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/system/catalog_sidecar.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/system/database.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/system/database.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/system/database_handle.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/system/database_handle.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/system/datapage.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/system/datapage.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/system/datatable.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/system/datatable.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/system/index_cache.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/system/index_cache.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/system/index_page.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/system/index_page.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/system/index_tree.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/system/index_tree.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/system/key_compare.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/system/key_compare.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/system/key_filter.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/system/key_filter.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/system/nonclustered_index.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/system/nonclustered_index.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/system/overflow.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/system/overflow.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/system/page_head.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/system/page_head.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/system/page_heatmap.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/system/page_heatmap.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/system/page_info.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/system/page_info.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/system/page_map.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/system/page_map.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/system/page_pool.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/system/page_pool.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/system/page_prefetch.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/system/page_prefetch.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/system/page_type.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/system/page_type.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/system/pfs_bitmap.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/system/pfs_bitmap.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/system/primary_key.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/system/primary_key.cpp.o.d"
+  "CMakeFiles/test_dataserver.dir/dataserver/system/usertable.cpp.o"
+  "CMakeFiles/test_dataserver.dir/dataserver/system/usertable.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_dataserver.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
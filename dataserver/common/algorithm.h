@@ -84,6 +84,19 @@ inline bool is_sorted(T const & result, fun_type compare) {
     return std::is_sorted(std::begin(result), std::end(result), compare);
 }
 
+// index of first element in [0, count) for which less(i) is false, count if none;
+// probe positions do not depend on branches, comparison result is used as conditional move
+template<class fun_type>
+inline size_t branchless_lower_bound(size_t count, fun_type && less) {
+    size_t first = 0;
+    while (count > 1) {
+        size_t const half = count / 2;
+        first = less(first + half - 1) ? (first + half) : first;
+        count -= half;
+    }
+    return count ? (first + (less(first) ? 1 : 0)) : first;
+}
+
 template<class T, class key_type>
 bool binary_insertion(T & result, key_type && unique_key) {
     ASSERT_SCOPE_EXIT_DEBUG_2([&result]{
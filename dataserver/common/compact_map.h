@@ -25,6 +25,15 @@ public:
     const_iterator end() const {
         return data.end();
     }
+    size_t size() const {
+        return data.size();
+    }
+    size_t capacity() const {
+        return data.capacity();
+    }
+    void clear() {
+        vector_type().swap(data); // release memory
+    }
     const_iterator find(const key_type & k) const {
         auto const i = std::lower_bound(data.begin(), data.end(), k, 
             [](value_type const & x, const key_type & k) {
@@ -26,6 +26,26 @@ public:
     mapped_type & operator()(key_type const & id, typename enum_1::type const t) {
         return table[static_cast<int>(t)][id];
     }
+    size_t size() const {
+        size_t result = 0;
+        for (auto const & m : table) {
+            result += m.size();
+        }
+        return result;
+    }
+    void clear() {
+        for (auto & m : table) {
+            m.clear();
+        }
+    }
+    template<class fun_type> // fun(key_type, enum_1::type, mapped_type)
+    void for_each(fun_type && fun) const {
+        for (int i = 0; i < enum_1::size; ++i) {
+            for (auto const & p : table[i]) {
+                fun(p.first, static_cast<typename enum_1::type>(i), p.second);
+            }
+        }
+    }
 };
 
 template<class map_type, class enum_1, class enum_2>
@@ -55,6 +75,35 @@ public:
     {
         return table[static_cast<int>(t1)][static_cast<int>(t2)][id];
     }
+    size_t size() const {
+        size_t result = 0;
+        for (auto const & row : table) {
+            for (auto const & m : row) {
+                result += m.size();
+            }
+        }
+        return result;
+    }
+    void clear() {
+        for (auto & row : table) {
+            for (auto & m : row) {
+                m.clear();
+            }
+        }
+    }
+    template<class fun_type> // fun(key_type, enum_1::type, enum_2::type, mapped_type)
+    void for_each(fun_type && fun) const {
+        for (int i = 0; i < enum_1::size; ++i) {
+            for (int j = 0; j < enum_2::size; ++j) {
+                for (auto const & p : table[i][j]) {
+                    fun(p.first, 
+                        static_cast<typename enum_1::type>(i), 
+                        static_cast<typename enum_2::type>(j), 
+                        p.second);
+                }
+            }
+        }
+    }
 };
 
 } // db
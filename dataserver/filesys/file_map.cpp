@@ -84,6 +84,11 @@ void const * FileMapping::GetFileView() const
     return nullptr;
 }
 
+uint64 FileMapping::GetFileSize(const char* filename)
+{
+    return data_t::filesize(filename);
+}
+
 uint64 FileMapping::GetFileSize() const
 {
     if (m_data.get()) {
@@ -7,6 +7,15 @@
 
 namespace sdl {
 
+// access pattern hint for mapped memory range
+enum class map_advice {
+    normal,
+    sequential, // aggressive readahead, pages can be freed soon after access
+    random,     // disable readahead
+    willneed,   // start reading pages in background
+    dontneed    // drop resident pages
+};
+
 class FileMapping: noncopyable 
 {
     using FileMapping_error = sdl_exception_t<FileMapping>;
@@ -26,6 +35,9 @@ public:
     
     uint64 GetFileSize() const;
 
+    // Returns size of file; throws if file cannot be opened
+    static uint64 GetFileSize(const char* filename);
+
 private:
     class data_t;
     std::unique_ptr<data_t> m_data;
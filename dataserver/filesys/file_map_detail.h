@@ -3,6 +3,8 @@
 #pragma once
 #ifndef __SDL_FILESYS_FILE_MAP_DETAIL_H__
 #define __SDL_FILESYS_FILE_MAP_DETAIL_H__
+
+#include "file_map.h"
 
 namespace sdl {
 
@@ -10,6 +12,7 @@ struct file_map_detail : is_static
 {
     typedef void * view_of_file;
     
+    // map [offset, offset + size) of the file; offset must be aligned to allocation granularity
     static view_of_file map_view_of_file(
         const char* filename,
         uint64 offset,
@@ -18,6 +21,20 @@ struct file_map_detail : is_static
     static bool unmap_view_of_file(view_of_file, 
         uint64 offset,
         uint64 size);    
+
+    // drop resident pages of the view; the view stays mapped and is paged in again on access
+    static bool release_view_of_file(view_of_file, uint64 size);
+
+    // address range must be inside a view; address is aligned down to page boundary
+    static bool advise_view_of_file(void const * address, uint64 size, map_advice);
+
+    // bytes of the view which are resident in memory; 0 if not supported
+    static uint64 resident_size_of_file(void const * address, uint64 size);
+
+    static uint64 allocation_granularity();
+
+    // path of file name in temporary directory (unit test files)
+    static std::string temp_path(const char* name);
 };
 
 } // sdl
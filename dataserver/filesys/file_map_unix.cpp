@@ -6,6 +6,7 @@
 #include "file_map_detail.h"
 #include "file_h.h"
 #include <sys/mman.h>
+#include <unistd.h>
 #include <utility>
 
 namespace sdl { namespace {
@@ -55,10 +56,9 @@ file_map_detail::map_view_of_file(const char* filename,
     A_STATIC_ASSERT_64_BIT; 
 
     SDL_ASSERT(size);
-    SDL_ASSERT(!offset); // current limitation
-    SDL_ASSERT(offset < size);
+    SDL_ASSERT(!(offset % allocation_granularity()));
 
-    if (size && (offset < size) && !offset) {
+    if (size && !(offset % allocation_granularity())) {
 
         FileHandler fp(filename, "rb");
         if (!fp.is_open()) {
@@ -68,7 +68,7 @@ file_map_detail::map_view_of_file(const char* filename,
         }
         auto pFileView = select_mmap64<has_mmap64::value>::get(
             nullptr, static_cast<size_t>(size), 
-            PROT_READ, MAP_PRIVATE, fileno(fp.get()), 0);
+            PROT_READ, MAP_PRIVATE, fileno(fp.get()), static_cast<off_t>(offset));
 
         if (pFileView == MAP_FAILED) {
             SDL_TRACE("mmap failed: ", filename);
@@ -87,7 +87,7 @@ bool file_map_detail::unmap_view_of_file(
     uint64 const size)
 {
     if (p) {
-        SDL_ASSERT(offset < size);
+        SDL_ASSERT(size);
         ::munmap(p, size);
         return true;
     }
@@ -96,6 +96,72 @@ bool file_map_detail::unmap_view_of_file(
     return false;
 }
 
+bool file_map_detail::release_view_of_file(view_of_file p, uint64 const size)
+{
+    if (p && size) {
+        return 0 == ::madvise(p, static_cast<size_t>(size), MADV_DONTNEED);
+    }
+    SDL_ASSERT(0);
+    return false;
+}
+
+bool file_map_detail::advise_view_of_file(void const * const p, uint64 const size, map_advice const advice)
+{
+    if (p && size) {
+        int flag = MADV_NORMAL;
+        switch (advice) {
+        case map_advice::sequential: flag = MADV_SEQUENTIAL; break;
+        case map_advice::random:     flag = MADV_RANDOM; break;
+        case map_advice::willneed:   flag = MADV_WILLNEED; break;
+        case map_advice::dontneed:   flag = MADV_DONTNEED; break;
+        default:
+            SDL_ASSERT(advice == map_advice::normal);
+            break;
+        }
+        const uintptr_t mask = static_cast<uintptr_t>(allocation_granularity() - 1);
+        const uintptr_t address = reinterpret_cast<uintptr_t>(p);
+        const uintptr_t aligned = address & ~mask;
+        return 0 == ::madvise(reinterpret_cast<void *>(aligned),
+            static_cast<size_t>(size + (address - aligned)), flag);
+    }
+    SDL_ASSERT(0);
+    return false;
+}
+
+uint64 file_map_detail::resident_size_of_file(void const * const p, uint64 const size)
+{
+    if (p && size) {
+        const uint64 page = allocation_granularity();
+        std::vector<unsigned char> vec(static_cast<size_t>((size + page - 1) / page));
+        if (0 == ::mincore(const_cast<void *>(p), static_cast<size_t>(size), vec.data())) {
+            uint64 count = 0;
+            for (auto const v : vec) {
+                count += (v & 1);
+            }
+            return count * page;
+        }
+        return 0;
+    }
+    SDL_ASSERT(0);
+    return 0;
+}
+
+uint64 file_map_detail::allocation_granularity()
+{
+    static const uint64 value = static_cast<uint64>(::sysconf(_SC_PAGESIZE));
+    return value;
+}
+
+std::string file_map_detail::temp_path(const char * const name)
+{
+    const char * const dir = ::getenv("TMPDIR");
+    std::string result(is_str_valid(dir) ? dir : "/tmp");
+    if (result.back() != '/') {
+        result += '/';
+    }
+    return result + name;
+}
+
 } // sdl
 
 #if SDL_DEBUG
@@ -63,19 +63,20 @@ file_map_detail::map_view_of_file(const char* filename,
     A_STATIC_ASSERT_64_BIT;
 
     SDL_ASSERT(size);
-    SDL_ASSERT(!offset); // current limitation
-    SDL_ASSERT(offset < size);
+    SDL_ASSERT(!(offset % allocation_granularity()));
 
-    if (size && (offset < size) && !offset) {
+    if (size && !(offset % allocation_granularity())) {
 
         filesize_64 fsize = {};
-        fsize.size = size;
+        fsize.size = offset + size;
+
+        filesize_64 foffset = {};
+        foffset.size = offset;
 
         static_assert(sizeof(DWORD) == 4, "");
         static_assert(sizeof(fsize.size) == 8, "");
         static_assert(sizeof(fsize.d.lo) == 4, "");
         static_assert(sizeof(fsize.d.hi) == 4, "");
-        SDL_ASSERT(fsize.d.lo);
 
         ReadFileHandler file(filename);
         if (!file.is_open()) {
@@ -103,8 +104,9 @@ file_map_detail::map_view_of_file(const char* filename,
         auto pFileView = ::MapViewOfFile(
             hFileMapping,
             FILE_MAP_READ,
-            0, 0,           // file offset where the view begins
-            0);             // mapping extends from the specified offset to the end of the file mapping.
+            foffset.d.hi,   // file offset where the view begins
+            foffset.d.lo, 
+            static_cast<SIZE_T>(size));
 
         ::CloseHandle(hFileMapping);
 
@@ -126,7 +128,7 @@ bool file_map_detail::unmap_view_of_file(
         uint64 const size)
 {
     if (p) {
-        SDL_ASSERT(offset < size);
+        SDL_ASSERT(size);
         ::UnmapViewOfFile(p);
         return true;
     }
@@ -135,6 +137,62 @@ bool file_map_detail::unmap_view_of_file(
     return false;
 }
 
+// Calling VirtualUnlock on a range of memory that is not locked 
+// releases the pages from the process's working set.
+bool file_map_detail::release_view_of_file(view_of_file p, uint64 const size)
+{
+    if (p && size) {
+        ::VirtualUnlock(p, static_cast<SIZE_T>(size));
+        return true;
+    }
+    SDL_ASSERT(0);
+    return false;
+}
+
+// Only dontneed has an equivalent for mapped views (working set trimming);
+// other hints are left to the cache manager.
+bool file_map_detail::advise_view_of_file(void const * const p, uint64 const size, map_advice const advice)
+{
+    if (p && size) {
+        if (advice == map_advice::dontneed) {
+            ::VirtualUnlock(const_cast<void *>(p), static_cast<SIZE_T>(size));
+            return true;
+        }
+        return false;
+    }
+    SDL_ASSERT(0);
+    return false;
+}
+
+// Working set of a view is not queried (QueryWorkingSetEx needs psapi).
+uint64 file_map_detail::resident_size_of_file(void const * const p, uint64 const size)
+{
+    SDL_ASSERT(p && size);
+    (void)p;
+    (void)size;
+    return 0;
+}
+
+uint64 file_map_detail::allocation_granularity()
+{
+    static const uint64 value = []() {
+        SYSTEM_INFO info;
+        ::GetSystemInfo(&info);
+        return static_cast<uint64>(info.dwAllocationGranularity);
+    }();
+    return value;
+}
+
+std::string file_map_detail::temp_path(const char * const name)
+{
+    char dir[MAX_PATH + 1] = {};
+    const DWORD len = ::GetTempPathA(MAX_PATH + 1, dir); // ends with backslash
+    if (len && (len <= MAX_PATH)) {
+        return std::string(dir, len) + name;
+    }
+    return name;
+}
+
 } // sdl
 
 #if SDL_DEBUG
@@ -153,4 +211,4 @@ namespace sdl {
     }
 } // sdl
 #endif //#if SV_DEBUG
-#endif //#if defined(SDL_OS_WIN32)
\ No newline at end of file
+#endif //#if defined(SDL_OS_WIN32)
\ No newline at end of file
@@ -0,0 +1,152 @@
+// file_read.cpp
+//
+#include "common/common.h"
+#include "file_read.h"
+#include "file_map.h"
+
+#if defined(SDL_OS_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/uio.h>
+#endif
+
+namespace sdl {
+
+#if defined(SDL_OS_WIN32)
+
+FileReader::FileReader(const char* filename)
+    : m_handle(INVALID_HANDLE_VALUE)
+{
+    m_fileSize = FileMapping::GetFileSize(filename);
+    m_handle = ::CreateFileA(filename, 
+        GENERIC_READ, 
+        FILE_SHARE_READ, 
+        nullptr, 
+        OPEN_EXISTING, 
+        FILE_FLAG_RANDOM_ACCESS, 
+        nullptr);
+    throw_error_if<FileReader_error>(!is_open(), "cannot open file");
+}
+
+FileReader::~FileReader()
+{
+    if (is_open()) {
+        ::CloseHandle(m_handle);
+    }
+}
+
+bool FileReader::is_open() const
+{
+    return m_handle != INVALID_HANDLE_VALUE;
+}
+
+bool FileReader::ReadAt(uint64 const offset, void * const buffer, size_t const size) const
+{
+    SDL_ASSERT(buffer && size && (size <= uint32(-1)));
+    OVERLAPPED ov = {};
+    ov.Offset = static_cast<DWORD>(offset);
+    ov.OffsetHigh = static_cast<DWORD>(offset >> 32);
+    DWORD done = 0;
+    if (::ReadFile(m_handle, buffer, static_cast<DWORD>(size), &done, &ov)) {
+        return done == size;
+    }
+    SDL_TRACE("ReadFile failed: ", GetLastError());
+    return false;
+}
+
+// ReadFileScatter requires unbuffered handle, read blocks one by one
+bool FileReader::ReadAt(uint64 const offset, void * const * const buffers, 
+                        size_t const count, size_t const block_size) const
+{
+    for (size_t i = 0; i < count; ++i) {
+        if (!ReadAt(offset + i * block_size, buffers[i], block_size)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#else // SDL_OS_UNIX
+
+FileReader::FileReader(const char* filename)
+    : m_fd(-1)
+{
+    m_fileSize = FileMapping::GetFileSize(filename);
+    m_fd = ::open(filename, O_RDONLY);
+    throw_error_if<FileReader_error>(!is_open(), "cannot open file");
+}
+
+FileReader::~FileReader()
+{
+    if (is_open()) {
+        ::close(m_fd);
+    }
+}
+
+bool FileReader::is_open() const
+{
+    return m_fd != -1;
+}
+
+bool FileReader::ReadAt(uint64 const offset, void * const buffer, size_t const size) const
+{
+    SDL_ASSERT(buffer && size);
+    char * dest = static_cast<char *>(buffer);
+    size_t done = 0;
+    while (done < size) {
+        const ssize_t n = ::pread(m_fd, dest + done, size - done, static_cast<off_t>(offset + done));
+        if (n > 0) {
+            done += static_cast<size_t>(n);
+        }
+        else if ((n < 0) && (errno == EINTR)) {
+            continue;
+        }
+        else {
+            SDL_TRACE("pread failed: ", errno);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool FileReader::ReadAt(uint64 const offset, void * const * const buffers, 
+                        size_t const count, size_t const block_size) const
+{
+    SDL_ASSERT(buffers && count && block_size);
+    enum { max_iov = 64 };
+    size_t done = 0; // blocks
+    while (done < count) {
+        struct iovec iov[max_iov];
+        const size_t n = a_min<size_t>(count - done, max_iov);
+        for (size_t i = 0; i < n; ++i) {
+            iov[i].iov_base = buffers[done + i];
+            iov[i].iov_len = block_size;
+        }
+        const uint64 pos = offset + done * block_size;
+        const ssize_t r = ::preadv(m_fd, iov, static_cast<int>(n), static_cast<off_t>(pos));
+        if ((r < 0) && (errno == EINTR)) {
+            continue;
+        }
+        if (r <= 0) {
+            SDL_TRACE("preadv failed: ", errno);
+            return false;
+        }
+        const size_t blocks = static_cast<size_t>(r) / block_size;
+        const size_t rest = static_cast<size_t>(r) % block_size;
+        if (rest) { // short read inside a block
+            char * const p = static_cast<char *>(buffers[done + blocks]);
+            if (!ReadAt(pos + blocks * block_size + rest, p + rest, block_size - rest)) {
+                return false;
+            }
+        }
+        done += blocks + (rest ? 1 : 0);
+    }
+    return true;
+}
+
+#endif // SDL_OS_WIN32
+
+} // namespace sdl
@@ -0,0 +1,37 @@
+// file_read.h
+//
+#pragma once
+#ifndef __SDL_FILESYS_FILE_READ_H__
+#define __SDL_FILESYS_FILE_READ_H__
+
+namespace sdl {
+
+// Read-only file with positional reads (pread), safe to use from several threads
+class FileReader : noncopyable
+{
+    using FileReader_error = sdl_exception_t<FileReader>;
+public:
+    explicit FileReader(const char* filename);
+    ~FileReader();
+
+    bool is_open() const;
+    uint64 GetFileSize() const {
+        return m_fileSize;
+    }
+    // Read size bytes at offset; returns false if less than size bytes were read
+    bool ReadAt(uint64 offset, void * buffer, size_t size) const;
+
+    // Read count blocks of block_size bytes at offset into separate buffers with one request (preadv)
+    bool ReadAt(uint64 offset, void * const * buffers, size_t count, size_t block_size) const;
+private:
+#if defined(SDL_OS_WIN32)
+    void * m_handle;
+#else
+    int m_fd;
+#endif
+    uint64 m_fileSize = 0;
+};
+
+} // namespace sdl
+
+#endif // __SDL_FILESYS_FILE_READ_H__
@@ -0,0 +1,343 @@
+// window_map.cpp
+//
+#include "common/common.h"
+#include "window_map.h"
+#include "file_map_detail.h"
+#include <fstream>
+#include <cstdio>
+
+namespace sdl { namespace {
+
+inline bool is_power_two(uint64 const x) {
+    return x && !(x & (x - 1));
+}
+
+inline size_t log_two(uint64 x) {
+    SDL_ASSERT(is_power_two(x));
+    size_t n = 0;
+    while (x >>= 1) {
+        ++n;
+    }
+    return n;
+}
+
+} // namespace
+
+WindowMapping::WindowMapping(const char * const filename,
+                             uint64 const window_size,
+                             size_t const window_limit)
+    : m_filename(is_str_valid(filename) ? filename : "")
+    , m_windowLimit(window_limit)
+    , m_residentCount(0)
+{
+    throw_error_if<WindowMapping_error>(!is_power_two(window_size), "window size must be power of two");
+    throw_error_if<WindowMapping_error>((window_size % file_map_detail::allocation_granularity()) != 0,
+        "window size must be multiple of allocation granularity");
+    m_fileSize = FileMapping::GetFileSize(filename);
+    throw_error_if<WindowMapping_error>(!m_fileSize, "empty file");
+    m_windowMask = window_size - 1;
+    m_windowShift = log_two(window_size);
+    const uint64 count = (m_fileSize + m_windowMask) >> m_windowShift;
+    SDL_ASSERT(count && (count < size_t(-1)));
+    m_windowCount = static_cast<size_t>(count);
+    m_window.reset(new window_t[m_windowCount]);
+    m_clock.reserve(a_min(m_windowLimit, m_windowCount));
+}
+
+WindowMapping::~WindowMapping()
+{
+    for (size_t i = 0; i < m_windowCount; ++i) {
+        if (auto const view = m_window[i].view.load()) {
+            file_map_detail::unmap_view_of_file(const_cast<char *>(view),
+                static_cast<uint64>(i) << m_windowShift, window_size(i));
+        }
+    }
+}
+
+uint64 WindowMapping::window_size(size_t const i) const
+{
+    SDL_ASSERT(i < m_windowCount);
+    const uint64 offset = static_cast<uint64>(i) << m_windowShift;
+    SDL_ASSERT(offset < m_fileSize);
+    return a_min(GetWindowSize(), m_fileSize - offset);
+}
+
+char const * WindowMapping::load_window(size_t const i) const
+{
+    SDL_ASSERT(i < m_windowCount);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return map_window(i, true);
+}
+
+char const * WindowMapping::map_window(size_t const i, bool const keep) const
+{
+    window_t & w = m_window[i];
+    if (keep) {
+        w.kept.store(true, std::memory_order_relaxed);
+    }
+    char const * view = w.view.load(std::memory_order_relaxed);
+    if (!view) {
+        view = static_cast<char const *>(file_map_detail::map_view_of_file(m_filename.c_str(),
+            static_cast<uint64>(i) << m_windowShift, window_size(i)));
+        throw_error_if<WindowMapping_error>(!view, "map_view_of_file failed");
+        if (m_advice != map_advice::normal) {
+            file_map_detail::advise_view_of_file(view, window_size(i), m_advice);
+        }
+        w.view.store(view, std::memory_order_relaxed);
+    }
+    w.ref.store(true, std::memory_order_relaxed);
+    if (!w.resident.load(std::memory_order_relaxed)) {
+        if (m_windowLimit) {
+            const size_t slot = (m_clock.size() < m_windowLimit) ? m_clock.size() : find_victim();
+            if (slot == m_clock.size()) { // below limit or all windows are pinned
+                m_clock.push_back(i);
+            }
+            else { // new window takes slot of released one
+                release_window(m_clock[slot]);
+                m_clock[slot] = i;
+            }
+        }
+        w.resident.store(true, std::memory_order_release);
+        ++m_residentCount;
+    }
+    return view;
+}
+
+// must be called under lock; windows accessed since last turn of the hand get second chance
+size_t WindowMapping::find_victim() const
+{
+    SDL_ASSERT(!m_clock.empty());
+    size_t unpinned = m_clock.size();
+    for (size_t n = 0; n < 2 * m_clock.size(); ++n) {
+        const size_t slot = m_hand;
+        if (++m_hand == m_clock.size()) {
+            m_hand = 0;
+        }
+        window_t & x = m_window[m_clock[slot]];
+        SDL_ASSERT(x.resident.load(std::memory_order_relaxed));
+        if (x.pin) {
+            continue;
+        }
+        if (!x.ref.load(std::memory_order_relaxed)) {
+            return slot;
+        }
+        x.ref.store(false, std::memory_order_relaxed);
+        unpinned = slot;
+    }
+    return unpinned; // reference bits are set again by concurrent readers
+}
+
+// must be called under lock
+void WindowMapping::release_window(size_t const i) const
+{
+    window_t & w = m_window[i];
+    if (w.resident.load(std::memory_order_relaxed)) {
+        w.resident.store(false, std::memory_order_relaxed);
+        --m_residentCount;
+        if (w.pin || w.kept.load(std::memory_order_relaxed)) {
+            // concurrent readers may still use the view; dropped pages are faulted in again
+            file_map_detail::release_view_of_file(const_cast<char *>(w.view.load(std::memory_order_relaxed)),
+                window_size(i));
+        }
+        else { // no address of window is held
+            unmap_window(i);
+        }
+    }
+}
+
+// must be called under lock
+void WindowMapping::unmap_window(size_t const i) const
+{
+    window_t & w = m_window[i];
+    SDL_ASSERT(!w.pin && !w.kept.load(std::memory_order_relaxed) && !w.resident.load(std::memory_order_relaxed));
+    if (char const * const view = w.view.exchange(nullptr, std::memory_order_relaxed)) {
+        file_map_detail::unmap_view_of_file(const_cast<char *>(view),
+            static_cast<uint64>(i) << m_windowShift, window_size(i));
+    }
+}
+
+void const * WindowMapping::Pin(uint64 const offset) const
+{
+    SDL_ASSERT(offset < m_fileSize);
+    const size_t i = static_cast<size_t>(offset >> m_windowShift);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    char const * const view = map_window(i, false);
+    ++m_window[i].pin;
+    return view + (offset & m_windowMask);
+}
+
+void WindowMapping::Unpin(uint64 const offset) const
+{
+    SDL_ASSERT(offset < m_fileSize);
+    const size_t i = static_cast<size_t>(offset >> m_windowShift);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    window_t & w = m_window[i];
+    SDL_ASSERT(w.pin);
+    if (w.pin && !(--w.pin) && !w.resident.load(std::memory_order_relaxed)
+        && !w.kept.load(std::memory_order_relaxed)) { // released while pinned
+        unmap_window(i);
+    }
+}
+
+void WindowMapping::ReleaseAll()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (size_t i = 0; i < m_windowCount; ++i) {
+        release_window(i);
+    }
+    m_clock.clear();
+    m_hand = 0;
+    SDL_ASSERT(!m_residentCount);
+}
+
+void WindowMapping::Advise(uint64 offset, uint64 const size, map_advice const advice) const
+{
+    SDL_ASSERT(offset + size <= m_fileSize);
+    const uint64 end = a_min(offset + size, m_fileSize);
+    std::lock_guard<std::mutex> lock(m_mutex); // view is not unmapped while advised
+    while (offset < end) {
+        const size_t i = static_cast<size_t>(offset >> m_windowShift);
+        const uint64 next = a_min((static_cast<uint64>(i) + 1) << m_windowShift, end);
+        char const * view = m_window[i].view.load(std::memory_order_relaxed);
+        if (!view && (advice == map_advice::willneed)) {
+            view = map_window(i, false);
+        }
+        if (view) {
+            file_map_detail::advise_view_of_file(view + (offset & m_windowMask), next - offset, advice);
+        }
+        offset = next;
+    }
+}
+
+void WindowMapping::SetDefaultAdvice(map_advice const advice)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_advice = advice;
+    for (size_t i = 0; i < m_windowCount; ++i) {
+        if (char const * const view = m_window[i].view.load(std::memory_order_relaxed)) {
+            file_map_detail::advise_view_of_file(view, window_size(i), advice);
+        }
+    }
+}
+
+size_t WindowMapping::GetMappedCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t count = 0;
+    for (size_t i = 0; i < m_windowCount; ++i) {
+        if (m_window[i].view.load(std::memory_order_relaxed)) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+uint64 WindowMapping::GetResidentSize() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    uint64 size = 0;
+    for (size_t i = 0; i < m_windowCount; ++i) {
+        if (char const * const view = m_window[i].view.load(std::memory_order_relaxed)) {
+            size += file_map_detail::resident_size_of_file(view, window_size(i));
+        }
+    }
+    return size;
+}
+
+uint64 WindowMapping::GetOffset(void const * const p) const
+{
+    char const * const address = static_cast<char const *>(p);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (size_t i = 0; i < m_windowCount; ++i) {
+        if (char const * const view = m_window[i].view.load(std::memory_order_relaxed)) {
+            if ((view <= address) && (address < view + window_size(i))) {
+                return (static_cast<uint64>(i) << m_windowShift) + (address - view);
+            }
+        }
+    }
+    return uint64(-1);
+}
+
+} // namespace sdl
+
+#if SDL_DEBUG
+namespace sdl {
+    namespace {
+        class unit_test {
+        public:
+            unit_test()
+            {
+                SDL_TRACE_FILE;
+                SDL_ASSERT(is_power_two(1));
+                SDL_ASSERT(is_power_two(64 * 1024));
+                SDL_ASSERT(!is_power_two(0));
+                SDL_ASSERT(!is_power_two(3 * 8192));
+                SDL_ASSERT(log_two(1) == 0);
+                SDL_ASSERT(log_two(8192) == 13);
+                SDL_ASSERT(log_two(uint64(1) << 40) == 40);
+                SDL_ASSERT(!(file_map_detail::allocation_granularity() % 4096));
+                if (1) { // resident windows are limited, released window is read again
+                    const uint64 size = file_map_detail::allocation_granularity();
+                    struct test_file : noncopyable { // removed on every path
+                        const std::string name = file_map_detail::temp_path("sdl_test_window.tmp");
+                        ~test_file() { std::remove(name.c_str()); }
+                    } const file;
+                    const std::string & name = file.name;
+                    {
+                        std::ofstream out(name, std::ofstream::out | std::ofstream::trunc | std::ofstream::binary);
+                        for (char i = 0; i < 4; ++i) {
+                            const std::vector<char> buf(static_cast<size_t>(size), i);
+                            out.write(buf.data(), buf.size());
+                        }
+                        SDL_ASSERT(out.good());
+                    }
+                    {
+                        WindowMapping test(name.c_str(), size, 2);
+                        SDL_ASSERT(test.GetWindowCount() == 4);
+                        for (size_t n = 0; n < 3; ++n) {
+                            for (size_t i = 0; i < 3; ++i) {
+                                char const * const p = static_cast<char const *>(test.GetAddress(i * size));
+                                SDL_ASSERT((p[0] == static_cast<char>(i)) && (p[size - 1] == static_cast<char>(i)));
+                                SDL_ASSERT(test.GetResidentCount() == a_min<size_t>(i + 1 + n * 3, 2));
+                            }
+                        }
+                        SDL_ASSERT(test.GetMappedCount() == 3); // address range is kept
+                        test.ReleaseAll();
+                        SDL_ASSERT(!test.GetResidentCount());
+                        SDL_ASSERT(*static_cast<char const *>(test.GetAddress(2 * size)) == 2);
+                        SDL_ASSERT(test.GetResidentCount() == 1);
+                        // pinned window is not released, unpinned one is unmapped by CLOCK
+                        char const * const pinned = static_cast<char const *>(test.Pin(3 * size));
+                        SDL_ASSERT((pinned[0] == 3) && (test.GetMappedCount() == 4));
+                        SDL_ASSERT(*static_cast<char const *>(test.GetAddress(0)) == 0);
+                        SDL_ASSERT(*static_cast<char const *>(test.GetAddress(size)) == 1);
+                        SDL_ASSERT((pinned[size - 1] == 3) && (test.GetMappedCount() == 4));
+                        test.Unpin(3 * size);
+                        for (size_t n = 0; n < 2; ++n) {
+                            SDL_ASSERT(*static_cast<char const *>(test.GetAddress(0)) == 0);
+                            SDL_ASSERT(*static_cast<char const *>(test.GetAddress(2 * size)) == 2);
+                        }
+                        SDL_ASSERT(test.GetMappedCount() == 3); // window 3 is unmapped
+                        SDL_ASSERT(test.GetOffset(pinned) == uint64(-1));
+                        char const * const p = static_cast<char const *>(test.Pin(3 * size));
+                        SDL_ASSERT((p[0] == 3) && (test.GetMappedCount() == 4));
+                        test.Unpin(3 * size);
+                    }
+                    {
+                        WindowMapping test(name.c_str(), size, 1); // window is unmapped after release
+                        for (size_t i = 0; i < 4; ++i) {
+                            char const * const p = static_cast<char const *>(test.Pin(i * size));
+                            SDL_ASSERT(p[size - 1] == static_cast<char>(i));
+                            test.Unpin(i * size);
+                            SDL_ASSERT((test.GetMappedCount() == 1) && (test.GetResidentCount() == 1));
+                        }
+                        test.ReleaseAll();
+                        SDL_ASSERT(!test.GetMappedCount());
+                    }
+                }
+            }
+        };
+        static unit_test s_test;
+    }
+} // sdl
+#endif //#if SV_DEBUG
@@ -0,0 +1,112 @@
+// window_map.h
+//
+#pragma once
+#ifndef __SDL_FILESYS_WINDOW_MAP_H__
+#define __SDL_FILESYS_WINDOW_MAP_H__
+
+#include "file_map.h"
+#include <mutex>
+#include <vector>
+
+namespace sdl {
+
+// Read-only file mapping split into fixed-size windows mapped on first access.
+// Resident windows above window_limit are released in CLOCK order (access sets reference bit), pinned windows are skipped.
+// GetAddress keeps window mapped until destructor, because page pointers are kept by caches and iterators
+// without pins: released kept window keeps its address range, its pages are dropped and faulted in again.
+// Windows reached only by Pin or Advise are unmapped when released and unpinned, like pool frames of pin_page.
+// So window_limit bounds resident memory; address space grows only with windows handed out by GetAddress.
+class WindowMapping : noncopyable
+{
+    using WindowMapping_error = sdl_exception_t<WindowMapping>;
+public:
+    // window_size : power of two, multiple of allocation granularity
+    // window_limit : max resident windows, 0 = no limit
+    WindowMapping(const char* filename, uint64 window_size, size_t window_limit);
+    ~WindowMapping();
+
+    uint64 GetFileSize() const {
+        return m_fileSize;
+    }
+    uint64 GetWindowSize() const {
+        return m_windowMask + 1;
+    }
+    size_t GetWindowCount() const {
+        return m_windowCount;
+    }
+    size_t GetWindowLimit() const {
+        return m_windowLimit;
+    }
+    size_t GetResidentCount() const {
+        return m_residentCount.load(std::memory_order_relaxed);
+    }
+    size_t GetMappedCount() const;
+    uint64 GetResidentSize() const; // resident bytes of mapped windows
+
+    // returns address of file offset; offset must be less than file size; window is never unmapped
+    void const * GetAddress(uint64 offset) const;
+
+    // address is valid until Unpin of the same window; then window can be unmapped
+    void const * Pin(uint64 offset) const;
+    void Unpin(uint64 offset) const;
+
+    // returns file offset of address or uint64(-1) if address is not mapped (diagnostic)
+    uint64 GetOffset(void const *) const;
+
+    // release all resident windows
+    void ReleaseAll();
+
+    // access hint for [offset, offset + size); willneed maps windows, other hints apply to mapped windows only
+    void Advise(uint64 offset, uint64 size, map_advice) const;
+
+    // hint applied to every window when it is mapped
+    void SetDefaultAdvice(map_advice);
+
+private:
+    struct window_t {
+        std::atomic<char const *> view;
+        std::atomic<bool> ref;      // CLOCK reference bit
+        std::atomic<bool> resident;
+        std::atomic<bool> kept;     // address returned by GetAddress
+        size_t pin = 0;             // guarded by m_mutex
+        window_t(): view(nullptr), ref(false), resident(false), kept(false) {}
+    };
+    char const * load_window(size_t) const;
+    char const * map_window(size_t, bool keep) const; // must be called under lock
+    void release_window(size_t) const;
+    void unmap_window(size_t) const;
+    size_t find_victim() const; // slot of m_clock, m_clock.size() if all windows are pinned
+    uint64 window_size(size_t) const;
+private:
+    const std::string m_filename;
+    uint64 m_fileSize = 0;
+    uint64 m_windowMask = 0;
+    size_t m_windowShift = 0;
+    size_t m_windowCount = 0;
+    size_t m_windowLimit = 0;
+    map_advice m_advice = map_advice::normal;
+    std::unique_ptr<window_t[]> m_window;
+    mutable std::vector<size_t> m_clock; // resident windows if window_limit is set
+    mutable size_t m_hand = 0;
+    mutable std::atomic<size_t> m_residentCount;
+    mutable std::mutex m_mutex;
+};
+
+inline void const *
+WindowMapping::GetAddress(uint64 const offset) const
+{
+    SDL_ASSERT(offset < m_fileSize);
+    const size_t i = static_cast<size_t>(offset >> m_windowShift);
+    window_t & w = m_window[i];
+    if (w.resident.load(std::memory_order_acquire) && w.kept.load(std::memory_order_relaxed)) {
+        if (!w.ref.load(std::memory_order_relaxed)) { // avoid write on hot path
+            w.ref.store(true, std::memory_order_relaxed);
+        }
+        return w.view.load(std::memory_order_relaxed) + (offset & m_windowMask);
+    }
+    return load_window(i) + (offset & m_windowMask);
+}
+
+} // namespace sdl
+
+#endif // __SDL_FILESYS_WINDOW_MAP_H__
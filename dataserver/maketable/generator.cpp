@@ -88,6 +88,7 @@ const char TYPE_LIST[] = R"(
 
 const char KEY_TEMPLATE[] = R"(, meta::key<%s{PK}, %s{key_pos}, sortorder::%s{key_order}>)";
 const char SPATIAL_KEY[] = R"(, meta::spatial_key)";
+const char INDEX_KEY[] = R"(, meta::index_key<sortorder::%s{key_order}>)";
 
 const char COL_TEMPLATE[] = R"(
         struct %s{col_name} : meta::col<%s{col_place}, %s{col_off}, scalartype::t_%s{col_type}, %s{col_len}%s{KEY_TEMPLATE}> { static constexpr char * name() { return "%s{col_name}"; } };)";
@@ -199,6 +200,11 @@ std::string generator::make_table(database const & db, datatable const & table,
                         s_key = SPATIAL_KEY;
                     }
                 }
+                else if (auto const index = table.find_nonclustered(i)) {
+                    if (db.get_cluster_index(tab.get_id())) { // found rows are ordered by cluster key
+                        s_key = replace_(INDEX_KEY, "%s{key_order}", to_string::type_name(index->col_ord(0)));
+                    }
+                }
             }
             replace(s_col, "%s{KEY_TEMPLATE}", s_key);
             s_columns += s_col;
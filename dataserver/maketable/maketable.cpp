@@ -10,11 +10,13 @@ struct dbo_META {
         struct Id : meta::col<0, 0, scalartype::t_int, 4, meta::key<true, 0, sortorder::ASC>> { static constexpr char * name() { return "Id"; } };
         struct Id2 : meta::col<1, 4, scalartype::t_bigint, 8, meta::key<true, 1, sortorder::DESC>> { static constexpr char * name() { return "Id2"; } };
         struct Col1 : meta::col<2, 12, scalartype::t_char, 255> { static constexpr char * name() { return "Col1"; } };
+        struct Col2 : meta::col<3, 267, scalartype::t_int, 4, meta::index_key<sortorder::DESC>> { static constexpr char * name() { return "Col2"; } };
     };
     typedef TL::Seq<
         col::Id
         ,col::Id2
         ,col::Col1
+        ,col::Col2
     >::Type type_list;
     struct clustered_META {
         using T0 = meta::index_col<col::Id>;
@@ -67,6 +69,7 @@ public:
         record() = default;
         auto Id() const -> col::Id::ret_type { return val<col::Id>(); }
         auto Col1() const -> col::Col1::ret_type { return val<col::Col1>(); }
+        auto Col2() const -> col::Col2::ret_type { return val<col::Col2>(); }
     };
     static constexpr size_t static_record_count = 0;
 public:
@@ -97,7 +100,7 @@ struct test_processor< Typelist<T, U> > {
 };
 void test_sample_table(sample::dbo_table * const table) {
     using T = sample::dbo_table;
-    static_assert(T::col_size == 3, "");
+    static_assert(T::col_size == 4, "");
     static_assert(T::col_fixed, "");
     static_assert(sizeof(T::record) == sizeof(void *), "");
     using clustered = T::clustered;
@@ -148,6 +151,20 @@ void test_sample_table(sample::dbo_table * const table) {
         if (auto p = tab->find_with_index(key)) {
             A_STATIC_CHECK_TYPE(T::record, p);
         }
+        auto const many = tab->find_many({ key, key });
+        SDL_ASSERT(many.size() == 2);
+        tab->scan_range(
+            query_type::make_bound_T0(key._0, true),
+            query_type::make_bound(key, false), query_type::scan_order::reverse, [](T::record){
+            return true;
+        });
+        auto const lower = tab->lower_bound(key._0);
+        if (lower.first.page) { // page is pinned after cursor of lower_bound is destroyed
+            SDL_ASSERT(lower.first.lock.get() == lower.first.page);
+            auto const next = tab->scan_next(lower.first, [](T::record){ return false; });
+            SDL_ASSERT((next.page == lower.first.page) && (next.slot == lower.first.slot) && next.lock);
+            tab->scan_prev(lower.first, [](T::record){ return true; });
+        }
         if (1) {
             using namespace where_;
             tab->SELECT | WHERE<T::col::Id>{1} | LESS<T::col::Id2>{1} | GREATER<T::col::Id2>{2};
@@ -160,6 +177,56 @@ void test_sample_table(sample::dbo_table * const table) {
             //FIXME: failed build on Ubuntu ?
             //auto r1 = (tab->SELECT | BETWEEN<T::col::Id>{1,2} && ORDER_BY<T::col::Id>{}).VALUES();
         }
+        if (1) { // nonclustered index
+            using namespace where_;
+            using namespace make_query_;
+            using E1 = decltype(tab->SELECT | WHERE<T::col::Col2>{1} && GREATER<T::col::Id2>{2});
+            using E2 = decltype(tab->SELECT | IN<T::col::Col2>{1,2} | BETWEEN<T::col::Col2>{5,7});
+            using E3 = decltype(tab->SELECT | LESS<T::col::Col2>{1} | WHERE<T::col::Id2>{1});
+            static_assert(IS_SEEK_TABLE<E1>::nonclustered_index, "");
+            static_assert(IS_SEEK_TABLE<E2>::nonclustered_index, "");
+            static_assert(IS_SCAN_TABLE<E3>::value, "");
+            auto const r1 = (tab->SELECT | WHERE<T::col::Col2>{1} && GREATER<T::col::Id2>{2}).VALUES();
+            auto const r2 = (tab->SELECT | IN<T::col::Col2>{1,2} | BETWEEN<T::col::Col2>{5,7}).VALUES();
+            auto const r3 = (tab->SELECT | GREATER_EQ<T::col::Col2>{1} && LESS_EQ<T::col::Col2>{9}).VALUES();
+            for (auto const & p : r1) {
+                SDL_ASSERT((p.Col2() == 1) && (p.val<T::col::Id2>() > 2));
+            }
+            using S1 = decltype(tab->SELECT | WHERE<T::col::Col2, INDEX::IGNORE>{1} && GREATER<T::col::Id2>{2});
+            using S3 = decltype(tab->SELECT | GREATER_EQ<T::col::Col2, INDEX::IGNORE>{1} && LESS_EQ<T::col::Col2, INDEX::IGNORE>{9});
+            static_assert(IS_SCAN_TABLE<S1>::value, "");
+            static_assert(IS_SCAN_TABLE<S3>::value, "");
+            auto const sorted_keys = [&tab](std::vector<T::record> const & range) { // index seek returns rows in index order
+                std::vector<key_type> keys;
+                for (auto const & p : range) {
+                    keys.push_back(tab->read_key(p));
+                }
+                std::sort(keys.begin(), keys.end(), [](key_type const & x, key_type const & y) {
+                    return x < y;
+                });
+                return keys;
+            };
+            auto const equal_keys = [](std::vector<key_type> const & x, std::vector<key_type> const & y) {
+                return (x.size() == y.size()) && std::equal(x.begin(), x.end(), y.begin(),
+                    [](key_type const & a, key_type const & b) {
+                    return a == b;
+                });
+            };
+            auto const s1 = (tab->SELECT | WHERE<T::col::Col2, INDEX::IGNORE>{1} && GREATER<T::col::Id2>{2}).VALUES();
+            auto const s2 = (tab->SELECT | IN<T::col::Col2, INDEX::IGNORE>{1,2} | BETWEEN<T::col::Col2, INDEX::IGNORE>{5,7}).VALUES();
+            auto const s3 = (tab->SELECT | GREATER_EQ<T::col::Col2, INDEX::IGNORE>{1} && LESS_EQ<T::col::Col2, INDEX::IGNORE>{9}).VALUES();
+            SDL_ASSERT(equal_keys(sorted_keys(r1), sorted_keys(s1)));
+            SDL_ASSERT(equal_keys(sorted_keys(r2), sorted_keys(s2)));
+            SDL_ASSERT(equal_keys(sorted_keys(r3), sorted_keys(s3)));
+            std::vector<T::record> s4;
+            tab->scan_if([&s4](T::record p){
+                if (((p.Col2() >= 1) && (p.Col2() <= 2)) || ((p.Col2() >= 5) && (p.Col2() <= 7))) {
+                    s4.push_back(p);
+                }
+                return true;
+            });
+            SDL_ASSERT(equal_keys(sorted_keys(r2), sorted_keys(s4)));
+        }
     }
     if (1) {
         using S = query_type;
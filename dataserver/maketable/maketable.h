@@ -8,6 +8,7 @@
 #include "maketable_where.h"
 #include "system/index_tree_t.h"
 #include "spatial/interval_set.h"
+#include <numeric>
 
 namespace sdl { namespace db { namespace make {
 
@@ -17,8 +18,9 @@ using where_::condition_t;
 struct page_slot {
     page_head const * page = nullptr;
     size_t slot = 0;
+    database::page_lock lock; // page is not evicted from buffer pool while page_slot is alive
     page_slot() = default;
-    page_slot(page_head const * p, size_t s): page(p), slot(s) {
+    page_slot(database::page_lock p, size_t s): page(p.get()), slot(s), lock(std::move(p)) {
         SDL_ASSERT(page && page->data.pageId);
     }
 };
@@ -63,10 +65,12 @@ public:
 private:
     this_table const & m_table;
     shared_cluster_index const m_cluster_index;
+    shared_index_cache const m_index_cache; // nullptr if disabled
 public:
     make_query(this_table const * p, database const * const d)
         : m_table(*p)
         , m_cluster_index(d->get_cluster_index(_schobj_id(this_table::id)))
+        , m_index_cache(d->get_index_cache(m_cluster_index))
     {
         SDL_ASSERT(meta::test_clustered<table_clustered>());
         SDL_ASSERT((index_size != 0) == !!m_cluster_index);
@@ -95,8 +99,23 @@ public:
         return find_with_index(make_key(std::forward<Ts>(params)...));
     }
     record find_with_index(key_type const &) const;
+    record_range find_many(std::vector<key_type> const &) const; // in order of keys, null record if not found
     std::pair<page_slot, bool> lower_bound(T0_type const &) const;
 
+    using key_bound = datatable::key_bound;
+    using scan_order = datatable::scan_order;
+    static key_bound make_bound(key_type const & key, bool const inclusive) { // key must outlive find_range
+        const char * const p = reinterpret_cast<const char *>(&key);
+        return key_bound(mem_range_t(p, p + sizeof(key_type)), inclusive);
+    }
+    static key_bound make_bound_T0(T0_type const & value, bool const inclusive) { // prefix of key
+        const char * const p = reinterpret_cast<const char *>(&value);
+        return key_bound(mem_range_t(p, p + sizeof(T0_type)), inclusive);
+    }
+    // records between bounds in index order or reverse, see datatable::find_range
+    template<class fun_type> // fun(record) returns bool or break_or_continue
+    break_or_continue scan_range(key_bound const & lo, key_bound const & hi, scan_order, fun_type &&) const;
+
     template<class fun_type> page_slot scan_next(page_slot const &, fun_type &&) const;
     template<class fun_type> page_slot scan_prev(page_slot const &, fun_type &&) const;
 
@@ -121,6 +140,7 @@ public:
 public:
     class seek_table; friend seek_table;
     class seek_spatial; friend seek_spatial;
+    class seek_index; friend seek_index;
 private:
     template<class T> // T = meta::index_col
     using key_index = TL::IndexOf<KEY_TYPE_LIST, T>;
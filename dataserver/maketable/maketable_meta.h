@@ -15,13 +15,15 @@ namespace sdl { namespace db { namespace make { namespace meta {
 enum class key_t {
     null, // no_key
     primary_key,
-    spatial_key
+    spatial_key,
+    index_key   // first column of nonclustered index
 };
 template<key_t KEY, size_t pos, sortorder ord>
 struct base_key {
     static constexpr key_t key = KEY;
     enum { PK = (key == key_t::primary_key) };
     enum { spatial_key = (key == key_t::spatial_key) };
+    enum { index_key = (key == key_t::index_key) };
     enum { key_pos = pos };
     static constexpr sortorder order = ord;
 };
@@ -31,6 +33,8 @@ using key = base_key<PK ? key_t::primary_key : key_t::null, pos, ord>;
 using key_true = key<true, 0, sortorder::ASC>;
 using key_false = key<false, 0, sortorder::NONE>;
 using spatial_key = base_key<key_t::spatial_key, 0, sortorder::ASC>;
+template<sortorder ord>
+using index_key = base_key<key_t::index_key, 0, ord>;
 
 template<scalartype::type v, int size>
 struct value_type {
@@ -8,11 +8,21 @@ namespace sdl { namespace db { namespace make {
 
 template<class this_table, class record>
 record make_query<this_table, record>::find_with_index(key_type const & key) const {
-    static_assert(index_size, "");
+    static_assert(index_size > 0, "");
     SDL_ASSERT(m_cluster_index);
     if (m_cluster_index && m_cluster_index->is_root_index()) { //FIXME: add info to metadata ?
+        key_filter const * const filter = m_table.get_table().get_key_filter().get();
+        if (filter) {
+            const char * const p = reinterpret_cast<const char *>(&key);
+            if (!filter->lookup(mem_range_t(p, p + sizeof(key_type)))) {
+                return {}; // key is not in table
+            }
+        }
         auto const db = m_table.get_db();
-        if (auto const id = make::index_tree<key_type>(db, m_cluster_index->root()).find_page(key)) {
+        auto const id = m_index_cache ?
+            make::index_tree<key_type>::find_page(*m_index_cache, key) :
+            make::index_tree<key_type>(db, m_cluster_index->root()).find_page(key);
+        if (id) {
             if (page_head const * const h = db->load_page_head(id)) {
                 SDL_ASSERT(h->is_data());
                 const datapage data(h);
@@ -28,6 +38,9 @@ record make_query<this_table, record>::find_with_index(key_type const & key) con
                             return get_record(head);
                         }
                     }
+                    if (filter) {
+                        filter->false_positive();
+                    }
                 }
             }
         }
@@ -39,6 +52,65 @@ record make_query<this_table, record>::find_with_index(key_type const & key) con
     });
 }
 
+template<class this_table, class record>
+typename make_query<this_table, record>::record_range
+make_query<this_table, record>::find_many(std::vector<key_type> const & keys) const {
+    static_assert(index_size > 0, "");
+    SDL_ASSERT(m_cluster_index);
+    record_range result;
+    result.reserve(keys.size());
+    if (!(m_cluster_index && m_cluster_index->is_root_index())) {
+        SDL_ASSERT(m_cluster_index->is_root_data());
+        for (auto const & key : keys) {
+            result.push_back(find_with_index(key));
+        }
+        return result;
+    }
+    std::vector<size_t> order(keys.size());
+    std::iota(order.begin(), order.end(), size_t(0));
+    std::sort(order.begin(), order.end(), [&keys](size_t const x, size_t const y) {
+        return keys[x] < keys[y];
+    });
+    auto const db = m_table.get_db();
+    make::index_tree<key_type> const tree(db, m_cluster_index->root());
+    std::vector<row_head const *> found(keys.size(), nullptr);
+    page_head const * page = nullptr;
+    database::page_lock lock; // page is not evicted from buffer pool while its keys are found
+    for (size_t const i : order) { // keys of one leaf page are found with one page visit
+        key_type const & key = keys[i];
+        if (page && (read_key(datapage(page).back()) < key)) {
+            page = nullptr;
+        }
+        if (!page) {
+            auto const id = m_index_cache ?
+                make::index_tree<key_type>::find_page(*m_index_cache, key) :
+                tree.find_page(key);
+            if (id) {
+                lock = db->lock_page(db->load_page_head(id));
+                page = lock.get();
+                SDL_ASSERT(page && page->is_data());
+                if (page && datapage(page).empty()) {
+                    page = nullptr;
+                }
+            }
+        }
+        if (page) {
+            const datapage data(page);
+            size_t const slot = data.lower_bound(
+                [this, &key](row_head const * const row) {
+                return (this->read_key(row) < key);
+            });
+            if ((slot < data.size()) && !(key < read_key(data[slot]))) {
+                found[i] = data[slot];
+            }
+        }
+    }
+    for (row_head const * const head : found) {
+        result.push_back(head ? get_record(head) : record());
+    }
+    return result;
+}
+
 template<class this_table, class record>
 std::pair<page_slot, bool>
 make_query<this_table, record>::lower_bound(T0_type const & value) const
@@ -46,39 +118,32 @@ make_query<this_table, record>::lower_bound(T0_type const & value) const
     static_assert(T0_col::order != sortorder::NONE, "");
     static_assert(index_size, "");
     SDL_ASSERT(m_cluster_index);
-    if (m_cluster_index && m_cluster_index->is_root_index()) { //FIXME: add info to metadata ?	
-		auto const db = m_table.get_db();
-		if (auto const id = make::index_tree<key_type>(db, m_cluster_index->root()).first_page(value)) {
-			if (page_head const * const h = db->load_page_head(id)) { //FIXME: must check previous pages for equal T0_type part of cluster key ?
-				SDL_ASSERT(h->is_data());
-				const datapage data(h);
-				if (!data.empty()) {
-					const size_t slot = data.lower_bound([this, &value](row_head const * const row) {
-						SDL_ASSERT(row->use_record()); //FIXME: check possibility
-						return this->key_less<T0_col>(row, value);
-					});
-					if (slot < data.size()) {
-						const bool is_equal = !this->key_less<T0_col>(value, data[slot]);
-						SDL_ASSERT(is_equal == meta::is_equal<T0_col>::equal(value, col_value<T0_col>(data[slot])));
-						return { page_slot(h, slot), is_equal };
-					}
-					auto next = db->load_next_head(h);
-					while (next) {
-						if (!datapage(next).empty()) {
-							return { page_slot(next, 0), false };
-						}
-						SDL_WARNING(0); // to be tested
-						next = db->load_next_head(next);
-					}
-				}
-			}
-		}
-		return {};
-	}
-	SDL_ASSERT(0);//FIXME: not implemented
+    if (m_cluster_index) { // first row with equal T0_type part of cluster key can be on previous page of index seek
+        auto const it = m_table.get_table().find_range(make_bound_T0(value, true), key_bound());
+        if (it) {
+            SDL_ASSERT(!this->key_less<T0_col>(it.head(), value));
+            const bool is_equal = !this->key_less<T0_col>(value, it.head());
+            SDL_ASSERT(is_equal == meta::is_equal<T0_col>::equal(value, col_value<T0_col>(it.head())));
+            SDL_ASSERT(it.lock().get() == it.page());
+            return { page_slot(it.lock(), it.slot()), is_equal };
+        }
+    }
     return {};
 }
 
+template<class this_table, class record>
+template<class fun_type> break_or_continue
+make_query<this_table, record>::scan_range(key_bound const & lo, key_bound const & hi, scan_order const order, fun_type && fun) const
+{
+    static_assert(index_size > 0, "");
+    for (auto it = m_table.get_table().find_range(lo, hi, order); it; it.next()) {
+        if (is_break(fun(get_record(it.head())))) {
+            return bc::break_;
+        }
+    }
+    return bc::continue_;
+}
+
 template<class this_table, class record>
 template<class fun_type> page_slot
 make_query<this_table, record>::scan_next(page_slot const & pos, fun_type && fun) const
@@ -89,11 +154,14 @@ make_query<this_table, record>::scan_next(page_slot const & pos, fun_type && fun
         size_t slot = pos.slot;
         page_head const * page = pos.page;
         SDL_ASSERT(slot < datapage(page).size());
+        database::page_lock lock; // current page is not evicted from buffer pool
         while (page) {
+            lock = db->lock_page(page);
+            page = lock.get();
             const datapage data(page);
             while (slot < data.size()) {
                 if (!fun(get_record(data[slot]))) {
-                    return { page, slot };
+                    return page_slot(lock, slot);
                 }
                 ++slot;
             }
@@ -117,7 +185,10 @@ make_query<this_table, record>::scan_prev(page_slot const & pos, fun_type && fun
         size_t slot = pos.slot;
         page_head const * page = pos.page;
         SDL_ASSERT(slot < datapage(page).size());
+        database::page_lock lock; // current page is not evicted from buffer pool
         while (page) {
+            lock = db->lock_page(page);
+            page = lock.get();
             const datapage data(page);
             if (!data.empty()) {
                 if (slot == datapage::none_slot) {
@@ -125,7 +196,7 @@ make_query<this_table, record>::scan_prev(page_slot const & pos, fun_type && fun
                 }
                 for (;;) {
                     if (!fun(get_record(data[slot]))) {
-                        return { page, slot };
+                        return page_slot(lock, slot);
                     }
                     if (!slot) {
                         slot = datapage::none_slot;
@@ -38,7 +38,7 @@ struct index_hint;
 
 template<class T>
 struct index_hint<T, true> { // allow INDEX::IGNORE|AUTO for any col
-    static_assert((T::hint != where_::INDEX::USE) || (T::col::PK || T::col::spatial_key), "INDEX::USE need primary key or spatial index");
+    static_assert((T::hint != where_::INDEX::USE) || (T::col::PK || T::col::spatial_key || T::col::index_key), "INDEX::USE need primary key, spatial or nonclustered index");
     static_assert((T::hint != where_::INDEX::USE) || (T::col::key_pos == 0), "INDEX::USE need key_pos 0");
     static_assert((T::hint != where_::INDEX::USE) || (T::cond != condition::NOT), "INDEX::USE cannot be used with condition::NOT");
     static constexpr where_::INDEX hint = T::hint;
@@ -92,6 +92,25 @@ public:
 
 //--------------------------------------------------------------
 
+template<class T, bool enabled = where_::is_condition_index<T::cond>::value>
+struct use_nonclustered; // first column of nonclustered index
+
+template<class T>
+struct use_nonclustered<T, true> {
+private:
+    static_assert(T::hint == index_hint<T>::hint, "use_nonclustered");
+public:
+    enum { value = T::col::index_key && !T::col::is_array && (T::hint != where_::INDEX::IGNORE) };
+};
+
+template<class T>
+struct use_nonclustered<T, false> {
+public:
+    enum { value = false };
+};
+
+//--------------------------------------------------------------
+
 template <class TList, class OList> struct check_index;
 template <> struct check_index<NullType, NullType>
 {
@@ -170,6 +189,23 @@ public:
     enum { value = temp && (OP == key_op) };
 };
 
+template <class T, operator_ OP, operator_ key_op> // T = where_::SEARCH
+struct select_nonclustered {
+private:
+    enum { temp = use_nonclustered<T>::value };
+public:
+    enum { value = temp && (OP == key_op) };
+};
+
+template <class T, operator_ OP, operator_ key_op> // T = where_::SEARCH
+struct select_no_nonclustered {
+private:
+    enum { search = where_::is_condition_search<T::cond>::value };
+    enum { temp = search && !use_nonclustered<T>::value };
+public:
+    enum { value = temp && (OP == key_op) };
+};
+
 //--------------------------------------------------------------
 
 template <class T, operator_ OP, operator_ key_op> // T = where_::SEARCH
@@ -245,6 +281,9 @@ protected:
     template <class T, operator_ OP> using _lambda_AND = select_lambda<T, OP, operator_::AND>;
     template <class T, operator_ OP> using _spatial_OR = select_spatial<T, OP, operator_::OR>;
     template <class T, operator_ OP> using _spatial_AND = select_spatial<T, OP, operator_::AND>;
+    template <class T, operator_ OP> using _index_OR = select_nonclustered<T, OP, operator_::OR>;
+    template <class T, operator_ OP> using _index_AND = select_nonclustered<T, OP, operator_::AND>;
+    template <class T, operator_ OP> using _no_index_OR = select_no_nonclustered<T, OP, operator_::OR>;
 };
 
 template<class sub_expr_type>
@@ -310,7 +349,25 @@ struct SEARCH_KEY : SEARCH_KEY_BASE
         0
     >::Result;
 
-    static_assert(TL::Length<search_OR>::value, "SEARCH_KEY: empty OR clause");
+    using index_OR = typename search_key<_index_OR,
+        typename sub_expr_type::type_list,
+        typename sub_expr_type::oper_list,
+        0
+    >::Result;
+
+    using index_AND = typename search_key<_index_AND,
+        typename sub_expr_type::type_list,
+        typename sub_expr_type::oper_list,
+        0
+    >::Result;
+
+    using no_index_OR = typename search_key<_no_index_OR,
+        typename sub_expr_type::type_list,
+        typename sub_expr_type::oper_list,
+        0
+    >::Result;
+
+    static_assert(TL::Length<search_OR>::value > 0, "SEARCH_KEY: empty OR clause");
 };
 
 } // search_key_ 
@@ -773,9 +830,13 @@ private:
     enum { spatial_OR = TL::Length<typename KEYS::spatial_OR>::value };
     enum { spatial_AND = TL::Length<typename KEYS::spatial_AND>::value };
     enum { lambda_OR = TL::Length<typename KEYS::lambda_OR>::value };
+    enum { index_OR = TL::Length<typename KEYS::index_OR>::value };
+    enum { index_AND = TL::Length<typename KEYS::index_AND>::value };
+    enum { no_index_OR = TL::Length<typename KEYS::no_index_OR>::value };
 public:
-    enum { use_index = !lambda_OR && (key_AND_0 || (key_OR_0 && !no_key_OR_0)) };
-    enum { spatial_index = !use_index && !lambda_OR && (spatial_AND || (spatial_OR && !no_key_OR_0)) };
+    enum { use_index = (lambda_OR == 0) && ((key_AND_0 > 0) || ((key_OR_0 > 0) && (no_key_OR_0 == 0))) };
+    enum { spatial_index = !use_index && (lambda_OR == 0) && ((spatial_AND > 0) || ((spatial_OR > 0) && (no_key_OR_0 == 0))) };
+    enum { nonclustered_index = !use_index && !spatial_index && (lambda_OR == 0) && ((index_AND > 0) || ((index_OR > 0) && (no_index_OR == 0))) };
 
 #if SDL_DEBUG_QUERY
     static void trace(){
@@ -786,8 +847,12 @@ public:
         SDL_TRACE("spatial_OR = ", spatial_OR);
         SDL_TRACE("spatial_AND = ", spatial_AND);
         SDL_TRACE("lambda_OR = ", lambda_OR);
+        SDL_TRACE("index_OR = ", index_OR);
+        SDL_TRACE("index_AND = ", index_AND);
+        SDL_TRACE("no_index_OR = ", no_index_OR);
         SDL_TRACE("use_index = ", use_index);
         SDL_TRACE("spatial_index = ", spatial_index);
+        SDL_TRACE("nonclustered_index = ", nonclustered_index);
     }
 #endif
 };
@@ -796,7 +861,7 @@ template<class sub_expr_type>
 struct IS_SCAN_TABLE {
     using seek_sub_expr = IS_SEEK_TABLE<sub_expr_type>;
 public:
-    enum { value = !seek_sub_expr::spatial_index && !seek_sub_expr::use_index };
+    enum { value = !seek_sub_expr::spatial_index && !seek_sub_expr::use_index && !seek_sub_expr::nonclustered_index };
 };
 
 //--------------------------------------------------------------
@@ -902,6 +967,8 @@ class make_query<this_table, _record>::seek_table final : is_static
     using record = typename query_type::record;
     using col_type = typename query_type::T0_col;
     using value_type = typename query_type::T0_type;
+    using key_bound = typename query_type::key_bound;
+    using scan_order = typename query_type::scan_order;
 
     static_assert(query_type::index_size, "seek_table need index_size");
 
@@ -981,18 +1048,8 @@ template<class this_table, class _record>
 template<class fun_type, class T> break_or_continue
 make_query<this_table, _record>::seek_table::scan_or_find(query_type & query, value_type const & value, fun_type && fun, identity<T>, std::true_type) {
     static_assert(is_composite, "");
-    break_or_continue result = bc::continue_;
-    auto const found = query.lower_bound(value);
-    if (found.second) {
-        A_STATIC_CHECK_TYPE(bool, found.second);
-        query.scan_next(found.first, [&result, &value, &fun](record const & p){
-            if (is_equal::apply(p, value)) {
-                return bc::continue_ == (result = fun(p));
-            }
-            return false;
-        });
-    }
-    return result;
+    auto const bound = query_type::make_bound_T0(value, true);
+    return query.scan_range(bound, bound, scan_order::forward, fun);
 }
 
 template<class this_table, class _record>
@@ -1034,38 +1091,16 @@ template<class this_table, class _record>
 template<class expr_type, class fun_type> break_or_continue
 make_query<this_table, _record>::seek_table::scan_greater(query_type & query, expr_type const * const expr, fun_type && fun)
 {
-    break_or_continue result = bc::continue_;
-    auto found = query.lower_bound(expr->value.values);
-    if (found.first.page) {
-        if (found.second) { // skip equal values
-            found.first = query.scan_next(found.first, [expr](record const & p){
-                return is_equal::apply(p, expr->value.values);
-            });
-        }
-        if (found.first.page) {
-            SDL_ASSERT(is_less<invert_sortorder<col_type::order>::value>::apply
-                (query.get_record(found.first), expr->value.values));
-            query.scan_next(found.first, [&result, &fun](record const & p){
-                return bc::continue_ == (result = fun(p));
-            });
-        }
-    }
-    return result;
+    // rows after value in index order
+    return query.scan_range(query_type::make_bound_T0(expr->value.values, false), key_bound(), scan_order::forward, fun);
 }
 
 template<class this_table, class _record> 
 template<class expr_type, class fun_type> break_or_continue
 make_query<this_table, _record>::seek_table::scan_greater_eq(query_type & query, expr_type const * const expr, fun_type && fun)
 {
-    break_or_continue result = bc::continue_;
-    auto found = query.lower_bound(expr->value.values);
-    if (found.first.page) {
-        SDL_ASSERT(is_less_eq<invert_sortorder<col_type::order>::value>::apply(query.get_record(found.first), expr->value.values));
-        query.scan_next(found.first, [&result, &fun](record const & p){
-            return bc::continue_ == (result = fun(p));
-        });
-    }
-    return result;
+    // rows from value in index order
+    return query.scan_range(query_type::make_bound_T0(expr->value.values, true), key_bound(), scan_order::forward, fun);
 }
 
 //--------------------------------------------------------------------------------
@@ -1138,34 +1173,18 @@ template<class this_table, class _record>
 template<class expr_type, class fun_type> inline break_or_continue
 make_query<this_table, _record>::seek_table::scan_between(query_type & query, expr_type const * const expr, fun_type && fun, sortorder_t<sortorder::ASC>) {
     static_assert(col_type::order == sortorder::ASC, "");
-    break_or_continue result = bc::continue_;
-    auto found = query.lower_bound(expr->value.values.first);
-    if (found.first.page) {
-        query.scan_next(found.first, [&result, expr, &fun](record const & p){
-            if (is_less_eq<sortorder::ASC>::apply(p, expr->value.values.second)) {
-                return bc::continue_ == (result = fun(p));
-            }
-            return false;
-        });
-    }
-    return result;
+    return query.scan_range(
+        query_type::make_bound_T0(expr->value.values.first, true),
+        query_type::make_bound_T0(expr->value.values.second, true), scan_order::forward, fun);
 }
 
 template<class this_table, class _record> 
 template<class expr_type, class fun_type> break_or_continue
 make_query<this_table, _record>::seek_table::scan_between(query_type & query, expr_type const * const expr, fun_type && fun, sortorder_t<sortorder::DESC>) {
     static_assert(col_type::order == sortorder::DESC, "");
-    break_or_continue result = bc::continue_;
-    auto found = query.lower_bound(expr->value.values.second);
-    if (found.first.page) {
-        query.scan_next(found.first, [&result, expr, &fun](record const & p){
-            if (is_less_eq<sortorder::DESC>::apply(p, expr->value.values.first)) {
-                return bc::continue_ == (result = fun(p));
-            }
-            return false;
-        });
-    }
-    return result;
+    return query.scan_range( // index order is inverted
+        query_type::make_bound_T0(expr->value.values.second, true),
+        query_type::make_bound_T0(expr->value.values.first, true), scan_order::forward, fun);
 }
 
 //--------------------------------------------------------------------------------
@@ -1205,6 +1224,131 @@ make_query<this_table, _record>::seek_table::scan_if(query_type & query, expr_ty
     return scan_between(query, expr, fun, sortorder_t<col_type::order>{});
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////
+
+template<class this_table, class _record> 
+class make_query<this_table, _record>::seek_index final : is_static
+{
+    using query_type = make_query<this_table, _record>;
+    using record = typename query_type::record;
+    using key_bound = typename query_type::key_bound;
+
+    template<class col> // col = meta::col with meta::index_key
+    using value_type = typename col::val_type;
+
+    template<class col> static
+    key_bound make_bound(value_type<col> const & value, bool const inclusive) { // value must outlive scan
+        const char * const p = reinterpret_cast<const char *>(&value);
+        return key_bound(mem_range_t(p, p + sizeof(value)), inclusive);
+    }
+    template<class col, class fun_type> static
+    break_or_continue scan(query_type &, key_bound const & lo, key_bound const & hi, fun_type &&);
+
+    // descending index column: values less than v follow v in index order
+    template<class col, class fun_type> static
+    break_or_continue scan_less(query_type & query, value_type<col> const & v, bool const inclusive, fun_type && fun) {
+        return (col::order == sortorder::DESC) ?
+            scan<col>(query, make_bound<col>(v, inclusive), key_bound(), fun) :
+            scan<col>(query, key_bound(), make_bound<col>(v, inclusive), fun);
+    }
+    template<class col, class fun_type> static
+    break_or_continue scan_greater(query_type & query, value_type<col> const & v, bool const inclusive, fun_type && fun) {
+        return (col::order == sortorder::DESC) ?
+            scan<col>(query, key_bound(), make_bound<col>(v, inclusive), fun) :
+            scan<col>(query, make_bound<col>(v, inclusive), key_bound(), fun);
+    }
+    template<class col, class fun_type> static
+    break_or_continue scan_where(query_type & query, value_type<col> const & v, fun_type && fun) {
+        auto const bound = make_bound<col>(v, true);
+        return scan<col>(query, bound, bound, fun);
+    }
+    // T = make_query_::SEARCH_WHERE
+    template<class expr_type, class fun_type, class T> static break_or_continue scan_if(query_type &, expr_type const *, fun_type &&, identity<T>, condition_t<condition::WHERE>);
+    template<class expr_type, class fun_type, class T> static break_or_continue scan_if(query_type &, expr_type const *, fun_type &&, identity<T>, condition_t<condition::IN>);
+    template<class expr_type, class fun_type, class T> static break_or_continue scan_if(query_type &, expr_type const *, fun_type &&, identity<T>, condition_t<condition::LESS>);
+    template<class expr_type, class fun_type, class T> static break_or_continue scan_if(query_type &, expr_type const *, fun_type &&, identity<T>, condition_t<condition::GREATER>);
+    template<class expr_type, class fun_type, class T> static break_or_continue scan_if(query_type &, expr_type const *, fun_type &&, identity<T>, condition_t<condition::LESS_EQ>);
+    template<class expr_type, class fun_type, class T> static break_or_continue scan_if(query_type &, expr_type const *, fun_type &&, identity<T>, condition_t<condition::GREATER_EQ>);
+    template<class expr_type, class fun_type, class T> static break_or_continue scan_if(query_type &, expr_type const *, fun_type &&, identity<T>, condition_t<condition::BETWEEN>);
+public:
+    // index of this database with first key column col and same sort order, nullptr if not found
+    template<class col> static
+    nonclustered_index const * find_index(query_type const & query) {
+        enum { col_index = TL::IndexOf<typename this_table::type_list, col>::value };
+        static_assert(col_index >= 0, "find_index");
+        if (auto const p = query.m_table.get_table().find_nonclustered(col_index)) {
+            if (p->col_ord(0) == col::order) {
+                return p;
+            }
+        }
+        return nullptr;
+    }
+    template<class expr_type, class fun_type, class T> 
+    static break_or_continue scan_if(query_type & query, expr_type const * v, fun_type && fun, identity<T>) {
+        static_assert(T::cond != condition::NOT, "");
+        static_assert(T::col::index_key, "");
+        return seek_index::scan_if(query, v, fun, identity<T>{}, condition_t<T::cond>{});
+    }
+};
+
+template<class this_table, class _record> 
+template<class col, class fun_type> break_or_continue
+make_query<this_table, _record>::seek_index::scan(query_type & query, key_bound const & lo, key_bound const & hi, fun_type && fun) {
+    nonclustered_index const * const index = find_index<col>(query);
+    if (!index) {
+        SDL_ASSERT(0); // checked by SEEK_INDEX
+        return bc::break_;
+    }
+    return query.m_table.get_table().scan_index(*index, lo, hi, [&query, &fun](datatable::record_type const & p) {
+        return fun(query.get_record(p.head()));
+    });
+}
+
+template<class this_table, class _record> template<class expr_type, class fun_type, class T> inline break_or_continue
+make_query<this_table, _record>::seek_index::scan_if(query_type & query, expr_type const * const expr, fun_type && fun, identity<T>, condition_t<condition::WHERE>) {
+    return scan_where<typename T::col>(query, expr->value.values, fun);
+}
+
+template<class this_table, class _record> template<class expr_type, class fun_type, class T> break_or_continue
+make_query<this_table, _record>::seek_index::scan_if(query_type & query, expr_type const * const expr, fun_type && fun, identity<T>, condition_t<condition::IN>) {
+    for (auto & v : expr->value.values) {
+        if (bc::break_ == scan_where<typename T::col>(query, v, fun)) {
+            return bc::break_;
+        }
+    }
+    return bc::continue_;
+}
+
+template<class this_table, class _record> template<class expr_type, class fun_type, class T> inline break_or_continue
+make_query<this_table, _record>::seek_index::scan_if(query_type & query, expr_type const * const expr, fun_type && fun, identity<T>, condition_t<condition::LESS>) {
+    return scan_less<typename T::col>(query, expr->value.values, false, fun);
+}
+
+template<class this_table, class _record> template<class expr_type, class fun_type, class T> inline break_or_continue
+make_query<this_table, _record>::seek_index::scan_if(query_type & query, expr_type const * const expr, fun_type && fun, identity<T>, condition_t<condition::LESS_EQ>) {
+    return scan_less<typename T::col>(query, expr->value.values, true, fun);
+}
+
+template<class this_table, class _record> template<class expr_type, class fun_type, class T> inline break_or_continue
+make_query<this_table, _record>::seek_index::scan_if(query_type & query, expr_type const * const expr, fun_type && fun, identity<T>, condition_t<condition::GREATER>) {
+    return scan_greater<typename T::col>(query, expr->value.values, false, fun);
+}
+
+template<class this_table, class _record> template<class expr_type, class fun_type, class T> inline break_or_continue
+make_query<this_table, _record>::seek_index::scan_if(query_type & query, expr_type const * const expr, fun_type && fun, identity<T>, condition_t<condition::GREATER_EQ>) {
+    return scan_greater<typename T::col>(query, expr->value.values, true, fun);
+}
+
+template<class this_table, class _record> template<class expr_type, class fun_type, class T> break_or_continue
+make_query<this_table, _record>::seek_index::scan_if(query_type & query, expr_type const * const expr, fun_type && fun, identity<T>, condition_t<condition::BETWEEN>) {
+    using col = typename T::col;
+    SDL_ASSERT(!(expr->value.values.second < expr->value.values.first));
+    auto const & v = expr->value.values;
+    return (col::order == sortorder::DESC) ? // index order is inverted
+        scan<col>(query, make_bound<col>(v.second, true), make_bound<col>(v.first, true), fun) :
+        scan<col>(query, make_bound<col>(v.first, true), make_bound<col>(v.second, true), fun);
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////
 #if 0  // moved to algorithm.h
 template<class T, class key_type>
@@ -1548,6 +1692,144 @@ void SEEK_SPATIAL<record_range, query_type, sub_expr_type, is_limit>::select()
 
 //---------------------------------------------------------------------------------
 
+template<class index_OR, class index_AND>
+struct SEEK_INDEX_KEYS { // AND: first condition is sought, others are checked with found records
+    using Result = Typelist<typename TL::TypeAt<index_AND, 0>::Result, NullType>;
+};
+
+template<class index_OR>
+struct SEEK_INDEX_KEYS<index_OR, NullType> {
+    using Result = index_OR;
+};
+
+template<class record_range, class query_type, class sub_expr_type, bool is_limit>
+class SEEK_INDEX final : noncopyable {
+
+    using this_type = SEEK_INDEX;
+    using record = typename query_type::record;
+    using key_type = typename query_type::key_type;
+
+    using KEYS = SEARCH_KEY<sub_expr_type>;
+    using index_OR = typename KEYS::index_OR;
+    using index_AND = typename KEYS::index_AND;
+    static_assert(TL::Length<index_OR>::value || TL::Length<index_AND>::value, "SEEK_INDEX");
+
+    using keylist = typename SEEK_INDEX_KEYS<index_OR, index_AND>::Result;
+
+    template<class expr_type, class T>
+    bool seek_with_index(expr_type const * const expr, identity<T>);
+    
+    struct seek_with_index_t {        
+        this_type * const m_this;
+        explicit seek_with_index_t(this_type * p) : m_this(p){}
+        template<class T> 
+        bool operator()(identity<T>) const { // T = SEARCH_WHERE
+            return m_this->seek_with_index(m_this->m_expr.get(Size2Type<T::offset>()), identity<T>{});
+        }
+    };
+    struct find_index_t {
+        query_type const & m_query;
+        bool & m_found;
+        find_index_t(query_type const & q, bool & f) : m_query(q), m_found(f){}
+        template<class T> 
+        bool operator()(identity<T>) const { // T = SEARCH_WHERE
+            m_found = (query_type::seek_index::template find_index<typename T::col>(m_query) != nullptr);
+            return m_found;
+        }
+    };
+    static bool has_limit(std::false_type) {
+        return false;
+    }
+    bool has_limit(std::true_type) const {
+        return m_limit <= m_result.size();
+    }
+    bool is_select(record const & p, operator_t<operator_::OR>) const;
+    bool is_select(record const & p, operator_t<operator_::AND>) const;
+    void scan_table(); // index is not found in database
+public:
+    record_range &          m_result;
+    query_type &            m_query;
+    sub_expr_type const &   m_expr;
+    const size_t            m_limit;
+
+    SEEK_INDEX(record_range & result, query_type & query, sub_expr_type const & expr, size_t const lim)
+        : m_result(result)
+        , m_query(query)
+        , m_expr(expr)
+        , m_limit(lim)
+    {
+        SDL_ASSERT(is_limit == (m_limit > 0));
+        static_assert(IS_SEEK_TABLE<sub_expr_type>::nonclustered_index, "SEEK_INDEX");
+    }
+    void select();
+};
+
+template<class record_range, class query_type, class sub_expr_type, bool is_limit> inline
+bool SEEK_INDEX<record_range, query_type, sub_expr_type, is_limit>::is_select(record const & p, operator_t<operator_::OR>) const
+{
+    return SELECT_AND<typename KEYS::search_AND, true>::select(p, m_expr); // must be
+}
+
+template<class record_range, class query_type, class sub_expr_type, bool is_limit> inline
+bool SEEK_INDEX<record_range, query_type, sub_expr_type, is_limit>::is_select(record const & p, operator_t<operator_::AND>) const
+{
+    return 
+        SELECT_OR<typename KEYS::search_OR, true>::select(p, m_expr) &&     // any of 
+        SELECT_AND<typename KEYS::search_AND, true>::select(p, m_expr);     // must be
+}
+
+template<class record_range, class query_type, class sub_expr_type, bool is_limit>
+template<class expr_type, class T> inline // T = SEARCH_WHERE
+bool SEEK_INDEX<record_range, query_type, sub_expr_type, is_limit>::seek_with_index(expr_type const * const expr, identity<T>)
+{
+    return query_type::seek_index::scan_if(m_query, expr, [this](record const p) {
+        if (is_select(p, operator_t<T::OP>{})) { // check other part of condition 
+            A_STATIC_ASSERT_NOT_TYPE(void, typename key_type::this_clustered);
+            auto const push_result = make_break_or_continue_bool(query_type::push_unique(m_result, p));
+            if (push_result.first == bc::break_) {
+                return bc::break_;
+            }
+            if (push_result.second && has_limit(bool_constant<is_limit>{})) {
+                return bc::break_;
+            }
+        }
+        return bc::continue_;
+    }, 
+    identity<T>{}) == bc::continue_;
+}
+
+template<class record_range, class query_type, class sub_expr_type, bool is_limit>
+void SEEK_INDEX<record_range, query_type, sub_expr_type, is_limit>::scan_table()
+{
+    m_query.scan_if([this](record const p){
+        if (SELECT_OR<typename KEYS::search_OR, true>::select(p, m_expr) &&
+            SELECT_AND<typename KEYS::search_AND, true>::select(p, m_expr)) {
+            auto const push_result = query_type::push_back(m_result, p);
+            if (push_result.first == bc::break_) {
+                return false;
+            }
+            if (push_result.second && has_limit(bool_constant<is_limit>{}))
+                return false;
+        }
+        return true;
+    });
+}
+
+template<class record_range, class query_type, class sub_expr_type, bool is_limit> inline
+void SEEK_INDEX<record_range, query_type, sub_expr_type, is_limit>::select()
+{
+    bool found = true;
+    meta::processor_if<keylist>::apply(find_index_t(m_query, found));
+    if (found) {
+        meta::processor_if<keylist>::apply(seek_with_index_t(this));
+    }
+    else {
+        scan_table();
+    }
+}
+
+//---------------------------------------------------------------------------------
+
 template<class sub_expr_type, class TOP = NullType>
 struct SCAN_OR_SEEK {
 private:
@@ -1573,13 +1855,15 @@ void SCAN_OR_SEEK<sub_expr_type, TOP>::select(record_range & result, query_type
     using scan_table_type = SCAN_TABLE<record_range, query_type, sub_expr_type, is_limit>;
     using seek_table_type = SEEK_TABLE<record_range, query_type, sub_expr_type, is_limit>;
     using seek_spatial_type = SEEK_SPATIAL<record_range, query_type, sub_expr_type, is_limit>;
+    using seek_index_type = SEEK_INDEX<record_range, query_type, sub_expr_type, is_limit>;
     using seek_sub_expr = IS_SEEK_TABLE<sub_expr_type>;
 #if SDL_DEBUG_QUERY
     seek_sub_expr::trace();
 #endif
     using select_table =
         Select_t<seek_sub_expr::spatial_index, seek_spatial_type, 
-        Select_t<seek_sub_expr::use_index, seek_table_type, scan_table_type>>;
+        Select_t<seek_sub_expr::use_index, seek_table_type,
+        Select_t<seek_sub_expr::nonclustered_index, seek_index_type, scan_table_type>>>;
     select_table(result, query, expr, limit(expr)).select();
 }
 
@@ -5,6 +5,7 @@
 #include "system/page_info.h"
 #include "system/database.h"
 #include "system/index_tree.h"
+#include "system/index_cache.h"
 #include "system/version.h"
 #include "maketable/generator.h"
 #include "maketable/generator_util.h"
@@ -20,6 +21,9 @@
 #include <fstream>
 #include <cstdlib> // atof
 #include <iomanip> // for std::setprecision
+#include <thread>
+#include <chrono>
+#include <functional>
 
 #if SDL_DEBUG_maketable
 #include "usertables/maketable_test.h"
@@ -77,6 +81,28 @@ struct cmd_option : noncopyable {
     db::make::export_database::param_type export_;
     int precision = 0;
     bool record_count = false;
+    size_t map_window = 0; // MB
+    size_t map_limit = 0;
+    bool random_only = false;
+    size_t prefetch = 0;
+    size_t pool_size = 0; // MB
+    bool warm_start = false;
+    size_t warm_threads = 0;
+    std::string ndf_file; // comma separated
+    size_t heatmap = 0; // number of hottest entries to print
+    bool catalog_sidecar = false;
+    size_t init_threads = 0;
+    size_t cache_bench = 0; // max number of threads
+    size_t datapage_limit = 0; // MB
+    size_t sysalloc_limit = 0; // MB
+    bool index_cache = false;
+    bool key_filter = false;
+    size_t key_filter_limit = 0; // KB per table
+    bool key_filter_sidecar = false;
+    size_t memory_usage = 0; // number of tables to print
+    std::string preload; // comma separated table names, * = all tables
+    size_t table_size = 0; // 1 = catalog and slot counts, 2 = exact record counts
+    size_t search_bench = 0; // number of keys
 };
 
 
@@ -942,6 +968,7 @@ void trace_table_index(db::database const & db, db::datatable & table, cmd_optio
     enum { test_find = 1 };
     enum { test_sorting = 1 };
     enum { test_reverse = 0 };
+    enum { test_range = 1 };
 
     if (auto tree = table.get_index_tree()) {
         auto const cluster_index = table.get_cluster_index();
@@ -1068,10 +1095,64 @@ void trace_table_index(db::database const & db, db::datatable & table, cmd_optio
                             }
                         }
                     }
+                    if (opt.verbosity > 1) {
+                        auto const found = table.find_many_t(std::vector<int32>(std::begin(keys), std::end(keys)));
+                        SDL_ASSERT(found.size() == A_ARRAY_SIZE(keys));
+                        for (size_t i = 0; i < found.size(); ++i) {
+                            SDL_ASSERT(found[i].head() == table.find_record_t(keys[i]).head());
+                        }
+                    }
                 }
             }
             std::cout << std::endl;
         }
+        if (test_range && (opt.verbosity > 1)) { // range cursor returns the same rows as filtered table scan
+            using row_set = std::vector<db::row_head const *>;
+            row_set all;
+            for (auto const record : table._record) {
+                all.push_back(record.head());
+            }
+            std::vector<char> lo, hi;
+            if (!all.empty()) {
+                lo = db::make_vector(db::datatable::record_type(&table, all[all.size() / 3]).get_cluster_key(*cluster_index));
+                hi = db::make_vector(db::datatable::record_type(&table, all[all.size() * 2 / 3]).get_cluster_key(*cluster_index));
+                if (tree->key_less(db::mem_range_t(hi.data(), hi.data() + hi.size()), db::mem_range_t(lo.data(), lo.data() + lo.size()))) {
+                    lo.swap(hi);
+                }
+            }
+            db::datatable::key_bound const lo_bound(db::mem_range_t(lo.data(), lo.data() + lo.size()), true);
+            db::datatable::key_bound const hi_bound(db::mem_range_t(hi.data(), hi.data() + hi.size()), false);
+            row_set expect;
+            for (auto const p : all) {
+                auto const key = db::datatable::record_type(&table, p).get_cluster_key(*cluster_index);
+                if (!tree->key_less(key, lo_bound.key) && tree->key_less(key, hi_bound.key)) {
+                    expect.push_back(p);
+                }
+            }
+            for (auto const order : { db::datatable::scan_order::forward, db::datatable::scan_order::reverse }) {
+                row_set found;
+                table.scan_range(db::datatable::key_bound(), db::datatable::key_bound(), order, [&found](db::datatable::record_type const & r) {
+                    found.push_back(r.head());
+                    return true;
+                });
+                SDL_ASSERT(found.size() == all.size());
+                std::sort(found.begin(), found.end());
+                row_set sorted(all);
+                std::sort(sorted.begin(), sorted.end());
+                SDL_ASSERT(found == sorted);
+                if (!all.empty()) {
+                    found.clear();
+                    table.scan_range(lo_bound, hi_bound, order, [&found](db::datatable::record_type const & r) {
+                        found.push_back(r.head());
+                        return true;
+                    });
+                    std::sort(found.begin(), found.end());
+                    std::sort(expect.begin(), expect.end());
+                    SDL_ASSERT(found == expect);
+                }
+            }
+            std::cout << "\nscan_range[" << table.name() << "] = " << expect.size() << " of " << all.size() << std::endl;
+        }
         if (opt.verbosity > 1) {
             size_t count = 0;
             for (auto const p : tree->_pages) {
@@ -1091,6 +1172,84 @@ void trace_table_index(db::database const & db, db::datatable & table, cmd_optio
     }
 }
 
+void trace_table_nonclustered(db::database const & db, db::datatable & table, cmd_option const & opt)
+{
+    using row_set = std::vector<db::row_head const *>;
+    row_set all;
+    for (auto const record : table._record) {
+        all.push_back(record.head());
+    }
+    std::sort(all.begin(), all.end());
+    for (auto const idx : db.index_for_table(table.get_id())) { // not supported index is not used by SEEK_INDEX
+        if ((idx->data.type == db::idxtype::nonclustered) && std::none_of(
+            table.get_nonclustered()->begin(), table.get_nonclustered()->end(),
+            [idx](db::shared_nonclustered_index const & p) { return p->idxstat == idx; })) {
+            std::cout << "\nnonclustered[" << table.name() << "] " << idx->name() << " = table scan";
+        }
+    }
+    for (auto const & index : *table.get_nonclustered()) {
+        db::key_compare const & compare = index->get_compare();
+        std::cout << "\nnonclustered[" << table.name() << "] " << index->name() << " =";
+        for (size_t i = 0; i < index->size(); ++i) {
+            std::cout << " " << (*index)[i].name;
+            SDL_ASSERT(db::nonclustered_index::is_key_column((*index)[i])); // variable length key is not supported
+        }
+        row_set found; // every row is found by its locator and keys are in index order
+        std::vector<char> prev, first;
+        const db::nonclustered_tree tree(&db, *index);
+        for (auto p = tree.seek({}, true); p.page; tree.next(p)) {
+            char const * const key = tree.leaf_key(p);
+            if (!prev.empty()) {
+                SDL_ASSERT(compare.compare(prev.data(), key, compare.size()) <= 0);
+            }
+            prev.assign(key, key + index->key_length());
+            auto const record = table.find_locator(*index, key);
+            SDL_ASSERT(record);
+            if (record) {
+                found.push_back(record.head());
+                if (!record.is_null(index->col_ind(0))) {
+                    first.insert(first.end(), key, key + index->sub_key_length(0));
+                }
+            }
+        }
+        std::sort(found.begin(), found.end());
+        SDL_ASSERT(found == all); // index is not filtered
+        std::cout << " rows = " << found.size();
+        size_t const len = index->sub_key_length(0);
+        size_t const count = first.size() / len;
+        if (!count || (opt.verbosity < 2)) {
+            continue;
+        }
+        // scan_index on [lo, hi) of first key column returns the same rows as filtered table scan
+        std::vector<char> const lo(first.begin() + (count / 3) * len, first.begin() + (count / 3 + 1) * len);
+        std::vector<char> const hi(first.begin() + (count * 2 / 3) * len, first.begin() + (count * 2 / 3 + 1) * len);
+        db::datatable::key_bound const lo_bound(db::mem_range_t(lo.data(), lo.data() + len), true);
+        db::datatable::key_bound const hi_bound(db::mem_range_t(hi.data(), hi.data() + len), false);
+        row_set expect;
+        for (auto const record : table._record) {
+            size_t const col = index->col_ind(0);
+            if (!record.is_null(col)) {
+                auto const value = db::make_vector(record.data_col(col));
+                SDL_ASSERT(value.size() == len);
+                if ((compare.compare_column(0, value.data(), lo.data()) >= 0) &&
+                    (compare.compare_column(0, value.data(), hi.data()) < 0)) {
+                    expect.push_back(record.head());
+                }
+            }
+        }
+        found.clear();
+        table.scan_index(*index, lo_bound, hi_bound, [&found](db::datatable::record_type const & r) {
+            found.push_back(r.head());
+            return true;
+        });
+        std::sort(found.begin(), found.end());
+        std::sort(expect.begin(), expect.end());
+        SDL_ASSERT(found == expect);
+        std::cout << " range = " << found.size();
+    }
+    std::cout << std::endl;
+}
+
 void trace_datatable(db::database const & db, db::datatable & table, cmd_option const & opt, bool const is_internal)
 {
     enum { trace_iam = 1 };
@@ -1181,6 +1340,7 @@ void trace_datatable(db::database const & db, db::datatable & table, cmd_option
         }
         if (opt.index) {
             trace_table_index(db, table, opt);
+            trace_table_nonclustered(db, table, opt);
         }
     }
     std::cout << std::endl;
@@ -2238,6 +2398,126 @@ void trace_index_for_table(db::database const & db, cmd_option const &)
     }
 }
 
+void trace_table_size(db::database const & db, cmd_option const & opt)
+{
+    using row_count = db::database::row_count;
+    auto const start = std::chrono::steady_clock::now();
+    for (auto const & ut : db._usertables) {
+        auto const id = ut->get_id();
+        auto const size = db.get_table_size(id);
+        std::cout << "\ntable_size[" << ut->name() << "]"
+            << " rows = " << size.rows
+            << " data_pages = " << size.data_pages
+            << " used_pages = " << size.used_pages
+            << " reserved_pages = " << size.reserved_pages
+            << " slots = " << db.count_rows(id, row_count::slots);
+        if (opt.table_size > 1) {
+            std::cout << " records = " << db.count_rows(id, row_count::records);
+        }
+    }
+    auto const ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    std::cout << "\ntable_size = " << ms << " ms" << std::endl;
+}
+
+void trace_cache_bench(db::database const & db, cmd_option const & opt)
+{
+    // every thread makes the same number of cached lookups over all user tables
+    db::vector_shared_usertable const tables(db._usertables.begin(), db._usertables.end());
+    if (tables.empty()) {
+        return;
+    }
+    size_t const rounds = a_max<size_t>(1000000 / tables.size(), 1);
+    auto const worker = [&db, &tables, rounds]() {
+        size_t found = 0;
+        for (size_t r = 0; r < rounds; ++r) {
+            for (auto const & ut : tables) {
+                auto const id = ut->get_id();
+                found += db.get_primary_key(id) ? 1 : 0;
+                found += db.get_cluster_index(ut) ? 1 : 0;
+                found += db.find_sysalloc(id, db::dataType::type::IN_ROW_DATA) ? 1 : 0;
+                found += db.find_spatial_tree(id).pgroot ? 1 : 0;
+            }
+        }
+        return found;
+    };
+    std::cout << "\ncache_bench: tables = " << tables.size() << " rounds = " << rounds;
+    for (size_t threads = 1; threads <= opt.cache_bench; threads *= 2) {
+        auto const start = std::chrono::steady_clock::now();
+        std::vector<std::thread> pool;
+        for (size_t t = 1; t < threads; ++t) {
+            pool.emplace_back(worker);
+        }
+        worker();
+        for (auto & t : pool) {
+            t.join();
+        }
+        auto const ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start).count();
+        size_t const lookups = threads * rounds * tables.size() * 4;
+        std::cout
+            << "\nthreads = " << threads
+            << " lookups = " << lookups
+            << " ms = " << ms
+            << " lookups/ms = " << (lookups / a_max<size_t>(static_cast<size_t>(ms), 1));
+    }
+    std::cout << std::endl;
+}
+
+void trace_search_bench(cmd_option const & opt)
+{
+    // sorted int keys 0, 2, 4.. searched with odd and even keys; no database is needed
+    using db::index_cache;
+    size_t const count = opt.search_bench;
+    std::vector<int32> keys(count);
+    index_cache cache(sizeof(int32), count + 1);
+    cache.push_back(nullptr, db::pageFileID{});
+    for (size_t i = 0; i < count; ++i) {
+        keys[i] = static_cast<int32>(i * 2);
+        db::pageFileID id{};
+        id.pageId = static_cast<uint32>(i + 1);
+        cache.push_back(reinterpret_cast<char const *>(&keys[i]), id);
+    }
+    cache.commit(true);
+    size_t const lookups = a_max<size_t>(count * 4, 1000000);
+    std::vector<int32> probe(lookups);
+    uint32 seed = 1;
+    for (auto & p : probe) {
+        seed = seed * 1103515245 + 12345;
+        p = static_cast<int32>(seed % (count * 2 + 1));
+    }
+    auto const bench = [&probe, lookups](const char * const name, std::function<size_t(int32)> const & fun) {
+        auto const start = std::chrono::steady_clock::now();
+        size_t sum = 0;
+        for (int32 const key : probe) {
+            sum += fun(key);
+        }
+        auto const ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+        std::cout << "\n" << name << " = " << (double(ns) / lookups) << " ns (" << sum << ")";
+    };
+    std::cout << "\nsearch_bench: keys = " << count << " lookups = " << lookups;
+    bench("std::lower_bound", [&keys](int32 const key) {
+        return size_t(std::lower_bound(keys.begin(), keys.end(), key,
+            [](int32 const x, int32 const y) { return x < y; }) - keys.begin());
+    });
+    bench("branchless_lower_bound", [&keys](int32 const key) {
+        int32 const * const data = keys.data();
+        return algo::branchless_lower_bound(keys.size(), [data, key](size_t const i) {
+            return data[i] < key;
+        });
+    });
+    bench("index_cache", [&cache](int32 const key) {
+        return size_t(cache.find_page(
+            [key](char const * p) { return index_cache::integer_key(p, sizeof(int32)) < key; },
+            [key](char const * p) { return key < index_cache::integer_key(p, sizeof(int32)); }).pageId);
+    });
+    bench("index_cache_int", [&cache](int32 const key) {
+        return size_t(cache.find_page(int64(key)).pageId);
+    });
+    std::cout << std::endl;
+}
+
 void maketables(db::database const & db, cmd_option const & opt)
 {
     if (!opt.out_file.empty()) {
@@ -2280,6 +2560,7 @@ void print_help(int argc, char* argv[])
         << "\nBuild time: " << __TIME__
         << "\nUsage: " << argv[0]
         << "\n[-i|--mdf_file] path to mdf file"
+        << "\n[--ndf_file] comma separated paths to secondary data files"
         << "\n[-o|--out_file] path to output files"
         << "\n[-d|--dump_mem] 0|1 : allow to dump memory"
         << "\n[-p|--page_num] int : index of the page to trace"
@@ -2316,6 +2597,27 @@ void print_help(int argc, char* argv[])
         << "\n[--export_out] output sql file"
         << "\n[--export_source] source database name"
         << "\n[--export_dest] dest database name"
+        << "\n[--map_window] int : map file by windows of size in MB (power of two)"
+        << "\n[--map_limit] int : max resident windows"
+        << "\n[--random_only] 0|1 : disable readahead and scan hints"
+        << "\n[--prefetch] int : number of pages to prefetch ahead of scan"
+        << "\n[--pool_size] int : read pages into buffer pool of size in MB instead of memory mapping"
+        << "\n[--warm_start] 0|1 : fault in mapping, catalog and index levels at open"
+        << "\n[--warm_threads] int : number of threads to populate mapping"
+        << "\n[--heatmap] int : count page loads and print hottest objects/levels"
+        << "\n[--catalog_sidecar] 0|1 : load catalog caches from sidecar file, rebuild it if stale"
+        << "\n[--init_threads] int : number of threads to initialize catalog (0 = hardware threads)"
+        << "\n[--cache_bench] int : measure cached metadata lookups from 1, 2, 4.. threads"
+        << "\n[--datapage_limit] int : MB of heap page runs and leaf page cache, 0 = no limit"
+        << "\n[--sysalloc_limit] int : MB of allocation unit cache, 0 = no limit"
+        << "\n[--index_cache] 0|1 : keep lowest non-leaf level of clustered indexes in memory"
+        << "\n[--key_filter] 0|1 : Bloom filter over cluster keys to reject missing keys without index search"
+        << "\n[--key_filter_limit] int : KB of one key filter, 0 = no limit"
+        << "\n[--key_filter_sidecar] 0|1 : save key filters next to database file, load them if not stale"
+        << "\n[--memory_usage] int : print memory of database caches and largest tables"
+        << "\n[--preload] comma separated tables to resolve after open, * = all tables"
+        << "\n[--table_size] 1|2 : print rows and pages of user tables, 2 = exact record count"
+        << "\n[--search_bench] int : time key search methods over number of sorted int keys"
         << std::endl;
 }
 
@@ -2332,6 +2634,7 @@ int run_main(cmd_option const & opt)
         std::cout
             << "\n--- called with: ---"
             << "\nmdf_file = " << opt.mdf_file
+            << "\nndf_file = " << opt.ndf_file
             << "\nout_file = " << opt.out_file
             << "\ndump_mem = " << opt.dump_mem
             << "\npage_num = " << opt.page_num
@@ -2381,6 +2684,27 @@ int run_main(cmd_option const & opt)
             << "\nexport_dest = " << opt.export_.dest   
             << "\nprecision = " << opt.precision
             << "\nrecord_count = " << opt.record_count
+            << "\nmap_window = " << opt.map_window
+            << "\nmap_limit = " << opt.map_limit
+            << "\nrandom_only = " << opt.random_only
+            << "\nprefetch = " << opt.prefetch
+            << "\npool_size = " << opt.pool_size
+            << "\nwarm_start = " << opt.warm_start
+            << "\nwarm_threads = " << opt.warm_threads
+            << "\nheatmap = " << opt.heatmap
+            << "\ncatalog_sidecar = " << opt.catalog_sidecar
+            << "\ninit_threads = " << opt.init_threads
+            << "\ncache_bench = " << opt.cache_bench
+            << "\ndatapage_limit = " << opt.datapage_limit
+            << "\nsysalloc_limit = " << opt.sysalloc_limit
+            << "\nindex_cache = " << opt.index_cache
+            << "\nkey_filter = " << opt.key_filter
+            << "\nkey_filter_limit = " << opt.key_filter_limit
+            << "\nkey_filter_sidecar = " << opt.key_filter_sidecar
+            << "\nmemory_usage = " << opt.memory_usage
+            << "\npreload = " << opt.preload
+            << "\ntable_size = " << opt.table_size
+            << "\nsearch_bench = " << opt.search_bench
             << std::endl;
     }
     if (opt.precision) {
@@ -2393,7 +2717,37 @@ int run_main(cmd_option const & opt)
         std::cerr << "\nexport database failed" << std::endl;
         return EXIT_FAILURE;
     }
-    db::database m_db(opt.mdf_file);
+    if (opt.search_bench) {
+        trace_search_bench(opt);
+        return EXIT_SUCCESS;
+    }
+    db::database_param param;
+    param.window_size = opt.map_window * (1024 * 1024);
+    param.window_limit = opt.map_limit;
+    param.random_only = opt.random_only;
+    param.prefetch_depth = opt.prefetch;
+    param.pool_size = opt.pool_size * (1024 * 1024 / db::page_head::page_size);
+    param.warm_start = opt.warm_start;
+    param.warm_threads = opt.warm_threads;
+    param.heatmap = (opt.heatmap != 0);
+    param.catalog_sidecar = opt.catalog_sidecar;
+    param.init_threads = opt.init_threads;
+    param.datapage_limit = opt.datapage_limit * (1024 * 1024);
+    param.sysalloc_limit = opt.sysalloc_limit * (1024 * 1024);
+    param.index_cache = opt.index_cache;
+    param.key_filter = opt.key_filter;
+    param.key_filter_limit = opt.key_filter_limit * 1024;
+    param.key_filter_sidecar = opt.key_filter_sidecar;
+    if (!opt.ndf_file.empty()) {
+        std::stringstream ss(opt.ndf_file);
+        std::string s;
+        while (std::getline(ss, s, ',')) {
+            if (!s.empty()) {
+                param.data_files.push_back(s);
+            }
+        }
+    }
+    db::database m_db(opt.mdf_file, param);
     db::database const & db = m_db;
     if (db.is_open()) {
         std::cout << "\ndatabase opened: " << db.filename() << std::endl;
@@ -2404,6 +2758,26 @@ int run_main(cmd_option const & opt)
     }
     const size_t page_count = db.page_count();
     std::cout << "page_count = " << page_count << std::endl;
+    std::cout << "file_count = " << db.file_count() << std::endl;
+    {
+        auto const & stat = db.get_open_stat();
+        std::cout
+            << "open_populate = " << stat.populate_ms << " ms (" << stat.populate_pages << " pages)"
+            << "\nopen_pfs = " << stat.pfs_ms << " ms (" << db.allocated_count() << " allocated pages)"
+            << "\nopen_catalog = " << stat.catalog_ms << " ms"
+            << "\nopen_index = " << stat.index_ms << " ms (" << stat.index_pages << " pages)"
+            << "\nopen_sidecar = " << (stat.sidecar_loaded ? "loaded" : "not loaded")
+            << " (rebuild " << stat.sidecar_ms << " ms)"
+            << std::endl;
+    }
+    if (!opt.preload.empty()) {
+        auto const start = std::chrono::steady_clock::now();
+        size_t const count = db.preload((opt.preload == "*") ? 
+            db::make::util::vector_string() : db::make::util::split(opt.preload, ','));
+        auto const ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start).count();
+        std::cout << "preload = " << ms << " ms (" << count << " tables)" << std::endl;
+    }
 
     if (opt.boot_page) {
         trace_boot_page(db, db.get_bootpage(), opt);
@@ -2467,6 +2841,97 @@ int run_main(cmd_option const & opt)
     if (opt.index_for_table) {
         trace_index_for_table(db, opt);
     }
+    if (opt.cache_bench) {
+        trace_cache_bench(db, opt);
+    }
+    if (opt.table_size) {
+        trace_table_size(db, opt);
+    }
+    if (opt.prefetch) {
+        auto const stat = db.get_prefetch_stat();
+        std::cout
+            << "\nprefetch_fetched = " << stat.fetched
+            << "\nprefetch_hit = " << stat.hit
+            << "\nprefetch_wasted = " << stat.wasted
+            << std::endl;
+    }
+    if (opt.pool_size) {
+        auto const stat = db.get_pool_stat();
+        std::cout
+            << "\npool_frames = " << stat.frames
+            << "\npool_hit = " << stat.hit
+            << "\npool_miss = " << stat.miss
+            << "\npool_evicted = " << stat.evicted
+            << "\npool_resident = " << stat.resident
+            << "\npool_batch_reads = " << stat.batch_reads
+            << std::endl;
+    }
+    if (opt.heatmap) {
+        std::map<db::schobj_id::type, std::string> names;
+        for (auto const & ut : db._usertables) {
+            names[ut->get_id()._32] = ut->name();
+        }
+        auto const heatmap = db.get_heatmap();
+        std::cout << "\nheatmap (" << heatmap.size() << ")";
+        for (size_t i = 0; (i < heatmap.size()) && (i < opt.heatmap); ++i) {
+            auto const & e = heatmap[i];
+            std::cout
+                << "\n[" << i << "] count = " << e.count
+                << " pages = " << e.pages
+                << " id = " << e.id._32
+                << " " << names[e.id._32]
+                << " indid = " << e.indid._32
+                << " level = " << e.level
+                << " type = " << db::to_string::type_name(e.type);
+        }
+        std::cout << std::endl;
+    }
+    if (opt.memory_usage) {
+        std::map<db::schobj_id::type, std::string> names;
+        for (auto const & ut : db._usertables) {
+            names[ut->get_id()._32] = ut->name();
+        }
+        auto const report = db.memory_usage();
+        auto const & t = report.total;
+        std::cout
+            << "\nmemory_sysalloc = " << t.sysalloc
+            << "\nmemory_datapage = " << t.datapage
+            << "\nmemory_pg_index = " << t.pg_index
+            << "\nmemory_primary = " << t.primary
+            << "\nmemory_cluster = " << t.cluster
+            << "\nmemory_spatial_tree = " << t.spatial_tree
+            << "\nmemory_index_cache = " << t.index_cache
+            << "\nmemory_key_filter = " << t.key_filter
+            << "\nmemory_catalog = " << t.catalog
+            << "\nmemory_pfs = " << t.pfs
+            << "\nmemory_pool = " << t.pool
+            << "\nmemory_heap = " << t.heap()
+            << "\nmemory_mapped = " << report.mapped
+            << "\nmemory_evicted = " << report.evicted;
+        for (size_t i = 0; (i < report.table.size()) && (i < opt.memory_usage); ++i) {
+            auto const & e = report.table[i];
+            std::cout
+                << "\n[" << i << "] bytes = " << e.stat.heap()
+                << " id = " << e.id._32
+                << " " << names[e.id._32]
+                << " sysalloc = " << e.stat.sysalloc
+                << " datapage = " << e.stat.datapage;
+            if (e.stat.key_filter) { // filter is built, stat shows lookups since then
+                if (auto const table = db.find_table(e.id)) {
+                    if (auto const filter = table->get_key_filter()) {
+                        auto const s = filter->get_stat();
+                        std::cout
+                            << " key_filter = " << e.stat.key_filter
+                            << " keys = " << filter->key_count()
+                            << " lookup = " << s.lookup
+                            << " negative = " << s.negative
+                            << " false_positive = " << s.false_positive;
+                    }
+                }
+            }
+        }
+        std::cout << std::endl;
+    }
     return EXIT_SUCCESS;
 }
 
@@ -2478,6 +2943,7 @@ int run_main(int argc, char* argv[])
 
     CmdLine cmd;
     cmd.add(make_option('i', opt.mdf_file, "mdf_file"));
+    cmd.add(make_option(0, opt.ndf_file, "ndf_file"));
     cmd.add(make_option('o', opt.out_file, "out_file"));
     cmd.add(make_option('d', opt.dump_mem, "dump_mem"));
     cmd.add(make_option('p', opt.page_num, "page_num"));
@@ -2529,13 +2995,34 @@ int run_main(int argc, char* argv[])
     cmd.add(make_option(0, opt.export_.dest, "export_dest"));
     cmd.add(make_option(0, opt.precision, "precision"));    
     cmd.add(make_option(0, opt.record_count, "record_count"));
+    cmd.add(make_option(0, opt.map_window, "map_window"));
+    cmd.add(make_option(0, opt.map_limit, "map_limit"));
+    cmd.add(make_option(0, opt.random_only, "random_only"));
+    cmd.add(make_option(0, opt.prefetch, "prefetch"));
+    cmd.add(make_option(0, opt.pool_size, "pool_size"));
+    cmd.add(make_option(0, opt.warm_start, "warm_start"));
+    cmd.add(make_option(0, opt.warm_threads, "warm_threads"));
+    cmd.add(make_option(0, opt.heatmap, "heatmap"));
+    cmd.add(make_option(0, opt.catalog_sidecar, "catalog_sidecar"));
+    cmd.add(make_option(0, opt.init_threads, "init_threads"));
+    cmd.add(make_option(0, opt.cache_bench, "cache_bench"));
+    cmd.add(make_option(0, opt.datapage_limit, "datapage_limit"));
+    cmd.add(make_option(0, opt.sysalloc_limit, "sysalloc_limit"));
+    cmd.add(make_option(0, opt.index_cache, "index_cache"));
+    cmd.add(make_option(0, opt.key_filter, "key_filter"));
+    cmd.add(make_option(0, opt.key_filter_limit, "key_filter_limit"));
+    cmd.add(make_option(0, opt.key_filter_sidecar, "key_filter_sidecar"));
+    cmd.add(make_option(0, opt.memory_usage, "memory_usage"));
+    cmd.add(make_option(0, opt.preload, "preload"));
+    cmd.add(make_option(0, opt.table_size, "table_size"));
+    cmd.add(make_option(0, opt.search_bench, "search_bench"));
 
     try {
         if (argc == 1) {
             throw std::string("Missing parameters");
         }
         cmd.process(argc, argv);
-        if (opt.mdf_file.empty() && opt.export_.empty()) {
+        if (opt.mdf_file.empty() && opt.export_.empty() && !opt.search_bench) {
             throw std::string("Missing input file");
         }
     }
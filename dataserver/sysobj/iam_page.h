@@ -75,6 +75,10 @@ public:
 
     template<class allocated_fun>
     void allocated_pages(database const * db, allocated_fun const &) const;
+
+    // extent_fun(start) is called before allocated pages of each uniform extent
+    template<class extent_fun, class allocated_fun>
+    void allocated_pages(database const * db, extent_fun const &, allocated_fun const &) const;
 };
 
 using shared_iam_page = std::shared_ptr<iam_page>;
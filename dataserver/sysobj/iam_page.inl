@@ -45,6 +45,14 @@ void iam_page::allocated_extents(allocated_fun const & fun) const
 
 template<class allocated_fun>
 void iam_page::allocated_pages(database const * const db, allocated_fun const & fun) const 
+{
+    allocated_pages(db, [](pageFileID const &){}, fun);
+}
+
+template<class extent_fun, class allocated_fun>
+void iam_page::allocated_pages(database const * const db, 
+                               extent_fun const & extent,
+                               allocated_fun const & fun) const 
 {
     SDL_ASSERT(db);
     if (iam_page_row const * const p = this->first()) {
@@ -53,8 +61,9 @@ void iam_page::allocated_pages(database const * const db, allocated_fun const &
                 fun(id);
             }
         }
-        allocated_extents([db, fun](pageFileID const & start) {
+        allocated_extents([db, &extent, &fun](pageFileID const & start) {
             if (fwd::is_allocated(db, start)) {
+                extent(start);
                 fun(start);
                 for (uint32 i = 1; i < 8; ++i) { // Eight consecutive pages form an extent
                     pageFileID id = start;
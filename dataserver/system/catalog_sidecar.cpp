@@ -0,0 +1,197 @@
+// catalog_sidecar.cpp
+//
+#include "common/common.h"
+#include "catalog_sidecar.h"
+#include <fstream>
+#include <cstdio>
+#include <chrono>
+
+namespace sdl { namespace db {
+
+#pragma pack(push, 1)
+struct catalog_sidecar::header_type {
+    char magic[8];
+    uint32 version;
+    key_type key;
+    uint32 entry_count;
+    uint32 record_count;
+};
+#pragma pack(pop)
+
+namespace {
+
+const char sidecar_magic[8] = { 'S', 'D', 'L', 'C', 'A', 'T', 'L', 'G' };
+const uint32 sidecar_version = 2; // heap entries are page runs
+
+} // namespace
+
+std::string catalog_sidecar::sidecar_name(const std::string & fname)
+{
+    return fname + ".catalog";
+}
+
+catalog_sidecar::catalog_sidecar(const std::string & fname)
+{
+    const std::string name = sidecar_name(fname);
+    if (!std::ifstream(name, std::ifstream::in | std::ifstream::binary).is_open()) {
+        return; // not created yet
+    }
+    char const * const view = static_cast<char const *>(m_fmap.CreateMapView(name.c_str()));
+    if (!view || (m_fmap.GetFileSize() < sizeof(header_type))) {
+        SDL_WARNING(!"bad sidecar");
+        return;
+    }
+    header_type const * const h = reinterpret_cast<header_type const *>(view);
+    const uint64 size = sizeof(header_type)
+        + uint64(h->entry_count) * sizeof(entry_type)
+        + uint64(h->record_count) * sizeof(recordID);
+    if (::memcmp(h->magic, sidecar_magic, sizeof(sidecar_magic)) || 
+        (h->version != sidecar_version) ||
+        (m_fmap.GetFileSize() != size)) {
+        SDL_WARNING(!"bad sidecar");
+        return;
+    }
+    m_entry = reinterpret_cast<entry_type const *>(view + sizeof(header_type));
+    m_record = reinterpret_cast<recordID const *>(m_entry + h->entry_count);
+    for (size_t i = 0; i < h->entry_count; ++i) {
+        if (uint64(m_entry[i].first) + m_entry[i].count > h->record_count) {
+            SDL_WARNING(!"bad sidecar");
+            return;
+        }
+    }
+    m_header = h;
+}
+
+catalog_sidecar::~catalog_sidecar()
+{
+}
+
+bool catalog_sidecar::is_same(key_type const & key) const
+{
+    return is_valid() && !::memcmp(&m_header->key, &key, sizeof(key));
+}
+
+size_t catalog_sidecar::size() const
+{
+    return is_valid() ? m_header->entry_count : 0;
+}
+
+catalog_sidecar::entry_type const &
+catalog_sidecar::operator[](size_t const i) const
+{
+    SDL_ASSERT(i < size());
+    return m_entry[i];
+}
+
+recordID const * catalog_sidecar::begin(entry_type const & e) const
+{
+    return m_record + e.first;
+}
+
+recordID const * catalog_sidecar::end(entry_type const & e) const
+{
+    return m_record + e.first + e.count;
+}
+
+bool catalog_sidecar::write(const std::string & fname,
+                            key_type const & key,
+                            vector_entry const & entry,
+                            vector_record const & record)
+{
+    const std::string name = sidecar_name(fname);
+    const std::string temp = name + ".tmp";
+    try {
+        {
+            std::ofstream out(temp, std::ofstream::out | std::ofstream::trunc | std::ofstream::binary);
+            throw_error_if<catalog_sidecar_error>(!out.is_open(), "cannot create sidecar");
+            header_type h;
+            memset_zero(h);
+            ::memcpy(h.magic, sidecar_magic, sizeof(sidecar_magic));
+            h.version = sidecar_version;
+            h.key = key;
+            h.entry_count = static_cast<uint32>(entry.size());
+            h.record_count = static_cast<uint32>(record.size());
+            out.write(reinterpret_cast<char const *>(&h), sizeof(h));
+            if (!entry.empty()) {
+                out.write(reinterpret_cast<char const *>(entry.data()), entry.size() * sizeof(entry_type));
+            }
+            if (!record.empty()) {
+                out.write(reinterpret_cast<char const *>(record.data()), record.size() * sizeof(recordID));
+            }
+            throw_error_if<catalog_sidecar_error>(!out.good(), "cannot write sidecar");
+        }
+        std::remove(name.c_str()); // rename does not replace existing file on Windows
+        throw_error_if<catalog_sidecar_error>(std::rename(temp.c_str(), name.c_str()) != 0, "cannot rename sidecar");
+        return true;
+    }
+    catch (sdl_exception & e) {
+        (void)e;
+        SDL_TRACE("sidecar: ", e.what());
+        std::remove(temp.c_str());
+    }
+    return false;
+}
+
+} // db
+} // sdl
+
+#if SDL_DEBUG
+namespace sdl {
+    namespace db {
+        namespace {
+            class unit_test {
+            public:
+                unit_test()
+                {
+                    SDL_TRACE_FILE;
+                    auto const ticks = std::chrono::steady_clock::now().time_since_epoch().count();
+                    const std::string fname = "sdl_test_sidecar_" + std::to_string(static_cast<long long>(ticks)) + ".mdf";
+                    SDL_ASSERT(!catalog_sidecar(fname).is_valid()); // not created yet
+                    catalog_sidecar::key_type key;
+                    memset_zero(key);
+                    key.file_size = 16 * 8192;
+                    key.boot_lsn.lsn1 = 10;
+                    key.checkpt_lsn.lsn1 = 20;
+                    catalog_sidecar::vector_entry entry(2);
+                    catalog_sidecar::vector_record record;
+                    for (size_t i = 0; i < 3; ++i) {
+                        pageFileID page;
+                        page.pageId = static_cast<uint32>(100 + i);
+                        page.fileId = 1;
+                        record.push_back(recordID::init(page, i));
+                    }
+                    memset_zero(entry[0]);
+                    entry[0].id._32 = 5;
+                    entry[0].kind = catalog_sidecar::kind_type::sysalloc;
+                    entry[0].count = 1;
+                    memset_zero(entry[1]);
+                    entry[1].id._32 = 7;
+                    entry[1].kind = catalog_sidecar::kind_type::pg_index;
+                    entry[1].page_type = static_cast<uint8>(pageType::type::data);
+                    entry[1].first = 1;
+                    entry[1].count = 2;
+                    SDL_ASSERT(catalog_sidecar::write(fname, key, entry, record));
+                    {
+                        const catalog_sidecar test(fname);
+                        SDL_ASSERT(test.is_valid() && test.is_same(key));
+                        SDL_ASSERT(test.size() == 2);
+                        SDL_ASSERT((test[0].id._32 == 5) && (test[0].kind == catalog_sidecar::kind_type::sysalloc));
+                        SDL_ASSERT((test[1].id._32 == 7) && (test[1].kind == catalog_sidecar::kind_type::pg_index));
+                        SDL_ASSERT(test.end(test[1]) - test.begin(test[1]) == 2);
+                        SDL_ASSERT(test.begin(test[1])->id.pageId == 101);
+                        SDL_ASSERT(test.begin(test[1])[1].slot == 2);
+                        catalog_sidecar::key_type stale = key; // database file was changed
+                        stale.file_size += 8192;
+                        SDL_ASSERT(!test.is_same(stale));
+                        stale = key;
+                        stale.checkpt_lsn.lsn2 = 1;
+                        SDL_ASSERT(!test.is_same(stale));
+                    }
+                    std::remove(catalog_sidecar::sidecar_name(fname).c_str());
+                }
+            };
+            static unit_test s_test;
+        }
+    } // db
+} // sdl
+#endif //#if SV_DEBUG
@@ -0,0 +1,74 @@
+// catalog_sidecar.h
+//
+#pragma once
+#ifndef __SDL_SYSTEM_CATALOG_SIDECAR_H__
+#define __SDL_SYSTEM_CATALOG_SIDECAR_H__
+
+#include "page_type.h"
+#include "filesys/file_map.h"
+
+namespace sdl { namespace db {
+
+// Binary file written next to the database file (fname + ".catalog") with resolved catalog caches:
+// allocation units, index roots, first/last leaf pages and heap page runs.
+// Values are stored as page locations, the file is memory mapped and used only while its key
+// (file size and boot page LSN) matches the database.
+class catalog_sidecar : noncopyable {
+    using catalog_sidecar_error = sdl_exception_t<catalog_sidecar>;
+public:
+    enum class kind_type : uint8 {
+        sysalloc,   // sysallocunits rows of (id, dataType)
+        pg_index,   // pgroot and pgfirst pages of (id, pageType)
+        heap,       // first and last page of every heap page run of (id, dataType, pageType)
+        clustered,  // first and last leaf pages of (id, dataType, pageType)
+        forward,    // first leaf page of (id, dataType, pageType)
+    };
+#pragma pack(push, 1)
+    struct key_type {
+        uint64 file_size;
+        pageLSN boot_lsn;       // boot page header
+        pageLSN checkpt_lsn;    // dbi_checkptLSN
+    };
+    struct entry_type {
+        schobj_id id;
+        kind_type kind;
+        uint8 data_type;
+        uint8 page_type;
+        uint8 reserved;
+        uint32 first;   // index of first record
+        uint32 count;   // number of records
+    };
+#pragma pack(pop)
+    using vector_entry = std::vector<entry_type>;
+    using vector_record = std::vector<recordID>;
+public:
+    static std::string sidecar_name(const std::string & fname);
+
+    // maps sidecar file; is_valid() is false if it is missing or damaged
+    explicit catalog_sidecar(const std::string & fname);
+    ~catalog_sidecar();
+
+    bool is_valid() const {
+        return m_header != nullptr;
+    }
+    bool is_same(key_type const &) const;
+
+    size_t size() const; // number of entries
+    entry_type const & operator[](size_t) const;
+    recordID const * begin(entry_type const &) const;
+    recordID const * end(entry_type const &) const;
+
+    // writes temporary file and replaces sidecar with it
+    static bool write(const std::string & fname, key_type const &, vector_entry const &, vector_record const &);
+private:
+    struct header_type;
+    FileMapping m_fmap;
+    header_type const * m_header = nullptr;
+    entry_type const * m_entry = nullptr;
+    recordID const * m_record = nullptr;
+};
+
+} // db
+} // sdl
+
+#endif // __SDL_SYSTEM_CATALOG_SIDECAR_H__
@@ -6,13 +6,166 @@
 #include "overflow.h"
 #include "database_fwd.h"
 #include "database_impl.h"
+#include "catalog_sidecar.h"
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <exception>
+#include <map>
+#include <tuple>
+#include <numeric>
 
 namespace sdl { namespace db {
 
 database::database(const std::string & fname)
-    : m_data(sdl::make_unique<shared_data>(fname))
+    : database(fname, database_param())
 {
-    init_database();
+}
+
+namespace {
+
+// calls fun(i) for i in [0, count) from several threads; first exception is rethrown by caller thread
+template<class fun_type>
+void parallel_for(size_t const count, size_t threads, fun_type const & fun)
+{
+    threads = a_min(a_max<size_t>(threads, 1), count);
+    if (threads <= 1) {
+        for (size_t i = 0; i < count; ++i) {
+            fun(i);
+        }
+        return;
+    }
+    std::atomic<size_t> next(0);
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    auto const worker = [count, &fun, &next, &error, &error_mutex]() {
+        try {
+            size_t i;
+            while ((i = next++) < count) {
+                fun(i);
+            }
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+            next = count; // stop other workers
+        }
+    };
+    std::vector<std::thread> workers;
+    for (size_t t = 1; t < threads; ++t) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (auto & w : workers) {
+        w.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void append_page_run(database::vector_page_run & runs, pageFileID const & id)
+{
+    SDL_ASSERT(id);
+    if (!runs.empty()) {
+        page_run & last = runs.back();
+        if ((last.first.fileId == id.fileId) && (last.first.pageId + last.count == id.pageId)) {
+            ++last.count;
+            return;
+        }
+    }
+    runs.push_back({ id, 1 });
+}
+
+// sort by first page and merge runs which overlap or touch
+void sort_page_runs(database::vector_page_run & runs)
+{
+    if (runs.empty()) {
+        return;
+    }
+    std::sort(runs.begin(), runs.end(), [](page_run const & x, page_run const & y) {
+        return x.first < y.first;
+    });
+    auto dest = runs.begin();
+    for (auto it = runs.begin() + 1; it != runs.end(); ++it) {
+        uint32 const end = dest->first.pageId + dest->count;
+        if ((dest->first.fileId == it->first.fileId) && (it->first.pageId <= end)) {
+            dest->count = a_max(end, it->first.pageId + it->count) - dest->first.pageId;
+        }
+        else {
+            *(++dest) = *it;
+        }
+    }
+    runs.erase(dest + 1, runs.end());
+}
+
+// approximate heap bytes of hash map nodes, buckets and vector values
+template<class T>
+size_t value_memory_size(T const &) {
+    return 0;
+}
+template<class T>
+size_t value_memory_size(std::vector<T> const & v) {
+    return v.capacity() * sizeof(T);
+}
+template<class map_type>
+size_t hash_memory_size(map_type const & m) {
+    size_t result = m.bucket_count() * sizeof(void *) + m.size() * (sizeof(typename map_type::value_type) + sizeof(void *));
+    for (auto const & p : m) {
+        result += value_memory_size(p.second);
+    }
+    return result;
+}
+
+class elapsed_ms : noncopyable {
+    using clock = std::chrono::steady_clock;
+    clock::time_point const start = clock::now();
+public:
+    size_t get() const {
+        return static_cast<size_t>(std::chrono::duration_cast<std::chrono::milliseconds>(clock::now() - start).count());
+    }
+};
+
+} // namespace
+
+database::database(const std::string & fname, database_param const & param)
+    : m_data(sdl::make_unique<shared_data>(fname, param))
+{
+    if (param.warm_start) {
+        const elapsed_ms timer;
+        const size_t threads = param.warm_threads ? param.warm_threads : std::thread::hardware_concurrency();
+        m_data->open.populate_pages = m_data->pm.populate(threads);
+        m_data->open.populate_ms = timer.get();
+    }
+    {
+        const elapsed_ms timer;
+        init_pfs_bitmap();
+        m_data->open.pfs_ms = timer.get();
+    }
+    {
+        const elapsed_ms timer;
+        if (param.catalog_sidecar) {
+            m_data->open.sidecar_loaded = load_sidecar();
+        }
+        init_database();
+        if (param.warm_start) {
+            preload({}); // datatables are lazy, resolve sysalloc, pg_index and datapage caches of every table
+        }
+        m_data->open.catalog_ms = timer.get();
+    }
+    if (param.warm_start) {
+        const elapsed_ms timer;
+        warm_index();
+        m_data->open.index_ms = timer.get();
+    }
+    if (param.catalog_sidecar && !m_data->open.sidecar_loaded) {
+        const elapsed_ms timer;
+        save_sidecar();
+        m_data->open.sidecar_ms = timer.get();
+    }
+    m_data->pm.reset_heatmap(); // do not count pages loaded by open
 }
 
 database::~database()
@@ -22,20 +175,297 @@ database::~database()
 void database::init_database()
 {
     SDL_TRACE_FUNCTION;
-    
+
+    init_catalog();
     _usertables.init(get_usertables());
     _internals.init(get_internals());
-    _datatables.init(get_datatables());
+    _datatables.init(get_usertables());
+    {
+        auto & catalog = m_data->catalog;
+        for (auto const & ut : _usertables) {
+            catalog.usertable_name.emplace(ut->name(), ut);
+            catalog.usertable_id.emplace(ut->get_id()._32, ut);
+        }
+        for (auto const & ut : _internals) {
+            catalog.internal_name.emplace(ut->name(), ut);
+            catalog.internal_id.emplace(ut->get_id()._32, ut);
+        }
+    }
+    m_data->initialized = true; // datatables and their caches are resolved on first use or by preload()
+}
+
+void database::init_pfs_bitmap()
+{
+    std::unique_ptr<pfs_bitmap> bitmap(new pfs_bitmap(m_data->pm.page_counts()));
+    parallel_for(bitmap->interval_count(), m_data->init_threads, [this, &bitmap](size_t const i){
+        if (const page_pin h{this, bitmap->interval(i)}) {
+            bitmap->set_interval(i, pfs_page(h.get()).row);
+        }
+    });
+    bitmap->commit();
+    m_data->pfs = std::move(bitmap);
+}
+
+void database::init_catalog()
+{
+    SDL_ASSERT(!m_data->initialized);
+    auto & catalog = m_data->catalog;
+    for_row(_sysidxstats, [&catalog](sysidxstats::const_pointer row) {
+        catalog.idxstats[row->data.id._32].push_back(row);
+    });
+    for_row(_sysallocunits, [&catalog](sysallocunits::const_pointer row) {
+        catalog.sysalloc[row->data.ownerid._64].push_back(row);
+    });
+    for_row(_syscolpars, [&catalog](syscolpars::const_pointer row) {
+        catalog.colpars[row->data.id._32].push_back(row);
+    });
+    for_row(_sysiscols, [&catalog](sysiscols::const_pointer row) {
+        catalog.iscols[row->data.idmajor._32].push_back(row);
+    });
+    for_row(_sysscalartypes, [&catalog](sysscalartypes::const_pointer row) {
+        catalog.scalartypes.emplace(row->data.id._32, row); // first row wins as with linear search
+    });
+    for_row(_sysrowsets, [&catalog](sysrowsets::const_pointer row) {
+        catalog.rowsets.emplace(row->data.rowsetid._64, row);
+    });
+}
+
+namespace {
+
+catalog_sidecar::key_type make_sidecar_key(database const & db)
+{
+    catalog_sidecar::key_type key;
+    memset_zero(key);
+    key.file_size = FileMapping::GetFileSize(db.filename().c_str());
+    if (auto const boot = db.get_bootpage()) {
+        key.boot_lsn = boot->head->data.lsn;
+        key.checkpt_lsn = boot->row->data.dbi_checkptLSN;
+    }
+    return key;
+}
+
+} // namespace
+
+bool database::load_sidecar()
+{
+    using class_clustered_access = page_head_access_t<clustered_access>;
+    using class_forward_access   = page_head_access_t<forward_access>;
+    using class_heap_access      = page_head_access_t<heap_access>;
+    using kind_type = catalog_sidecar::kind_type;
+    const catalog_sidecar sidecar(filename());
+    if (!sidecar.is_same(make_sidecar_key(*this))) {
+        return false;
+    }
+    struct sysalloc_type {
+        schobj_id id;
+        dataType::type data_type;
+        shared_sysallocunits value;
+    };
+    struct pg_index_type {
+        schobj_id id;
+        pageType::type page_type;
+        pgroot_pgfirst value;
+    };
+    struct datapage_type {
+        schobj_id id;
+        dataType::type data_type;
+        pageType::type page_type;
+        shared_page_head_access value;
+    };
+    std::vector<sysalloc_type> sysalloc;
+    std::vector<pg_index_type> pg_index;
+    std::vector<datapage_type> datapage;
+    try { // all entries are checked before caches are filled
+        for (size_t i = 0; i < sidecar.size(); ++i) {
+            auto const & e = sidecar[i];
+            recordID const * const first = sidecar.begin(e);
+            recordID const * const last = sidecar.end(e);
+            throw_error_if<database_error>((e.data_type >= dataType::size) || (e.page_type >= pageType::size), 
+                "bad sidecar entry");
+            auto const data_type = static_cast<dataType::type>(e.data_type);
+            auto const page_type = static_cast<pageType::type>(e.page_type);
+            auto const load_page = [this](recordID const & r) { // pointers are cached
+                page_head const * const p = this->load_resident_head(r.id);
+                throw_error_if<database_error>(!p, "bad sidecar page");
+                return p;
+            };
+            switch (e.kind) {
+            case kind_type::sysalloc: {
+                    shared_sysallocunits value(new vector_sysallocunits_row);
+                    for (auto it = first; it != last; ++it) {
+                        const sysallocunits page(load_page(*it));
+                        throw_error_if<database_error>(it->slot >= page.size(), "bad sidecar slot");
+                        value->push_back(page[it->slot]);
+                    }
+                    sysalloc.push_back({ e.id, data_type, value });
+                }
+                break;
+            case kind_type::pg_index:
+                throw_error_if<database_error>((e.count != 0) && (e.count != 2), "bad sidecar entry");
+                if (e.count) {
+                    pg_index.push_back({ e.id, page_type, pgroot_pgfirst(load_page(first[0]), load_page(first[1])) });
+                }
+                else {
+                    pg_index.push_back({ e.id, page_type, pgroot_pgfirst() });
+                }
+                break;
+            case kind_type::heap: { // first and last page of every run
+                    throw_error_if<database_error>(e.count % 2, "bad sidecar entry");
+                    vector_page_run runs;
+                    runs.reserve(e.count / 2);
+                    for (auto it = first; it != last; it += 2) {
+                        pageFileID const & p1 = it[0].id;
+                        pageFileID const & p2 = it[1].id;
+                        throw_error_if<database_error>(!p1 || (p1.fileId != p2.fileId) || (p2.pageId < p1.pageId) ||
+                            (p2.pageId >= m_data->pm.page_count(p2.fileId)), "bad sidecar page");
+                        runs.push_back({ p1, p2.pageId - p1.pageId + 1 });
+                    }
+                    shared_page_head_access value;
+                    reset_shared<class_heap_access>(value, this, std::move(runs), page_type);
+                    datapage.push_back({ e.id, data_type, page_type, value });
+                }
+                break;
+            case kind_type::clustered: {
+                    throw_error_if<database_error>(e.count != 2, "bad sidecar entry");
+                    shared_page_head_access value;
+                    reset_shared<class_clustered_access>(value, this, e.id, load_page(first[0]), load_page(first[1]));
+                    datapage.push_back({ e.id, data_type, page_type, value });
+                }
+                break;
+            case kind_type::forward: {
+                    throw_error_if<database_error>(e.count != 1, "bad sidecar entry");
+                    shared_page_head_access value;
+                    reset_shared<class_forward_access>(value, this, load_page(first[0]));
+                    datapage.push_back({ e.id, data_type, page_type, value });
+                }
+                break;
+            default:
+                throw_error<database_error>("bad sidecar entry");
+                break;
+            }
+        }
+    }
+    catch (sdl_exception & e) {
+        (void)e;
+        SDL_TRACE("sidecar: ", e.what());
+        return false;
+    }
+    for (auto const & s : sysalloc) {
+        m_data->set_sysalloc(s.id, s.data_type, s.value);
+    }
+    for (auto const & s : pg_index) {
+        m_data->set_pg_index(s.id, s.page_type, s.value);
+    }
+    for (auto const & s : datapage) {
+        m_data->set_datapage(s.id, s.data_type, s.page_type, s.value);
+    }
+    return true;
+}
+
+void database::save_sidecar()
+{
+    using class_clustered_access = page_head_access_t<clustered_access>;
+    using class_forward_access   = page_head_access_t<forward_access>;
+    using class_heap_access      = page_head_access_t<heap_access>;
+    using kind_type = catalog_sidecar::kind_type;
+    preload({}); // caches of every table
+    for (auto const & ut : _usertables) { // heap page lists and leaf pages of every table
+        find_datapage(ut->get_id(), dataType::type::IN_ROW_DATA, pageType::type::data);
+    }
+    std::map<sysallocunits_row const *, recordID> location;
+    for (auto const & p : _sysallocunits) {
+        for (size_t i = 0; i < p->size(); ++i) {
+            location[(*p)[i]] = recordID::init(p->head->data.pageId, i);
+        }
+    }
+    catalog_sidecar::vector_entry entries;
+    catalog_sidecar::vector_record records;
+    auto const add_entry = [&entries, &records](schobj_id const id, kind_type const kind, 
+        int const data_type, int const page_type) {
+        catalog_sidecar::entry_type e;
+        memset_zero(e);
+        e.id = id;
+        e.kind = kind;
+        e.data_type = static_cast<uint8>(data_type);
+        e.page_type = static_cast<uint8>(page_type);
+        e.first = static_cast<uint32>(records.size());
+        entries.push_back(e);
+    };
+    auto const add_page = [&entries, &records](page_head const * const p) {
+        records.push_back(recordID::init(p->data.pageId));
+        ++(entries.back().count);
+    };
+    bool complete = true;
+    m_data->for_sysalloc([&](schobj_id const id, dataType::type const data_type, shared_sysallocunits const & value) {
+        add_entry(id, kind_type::sysalloc, static_cast<int>(data_type), 0);
+        for (auto const row : *value) {
+            auto const found = location.find(row);
+            if (found != location.end()) {
+                records.push_back(found->second);
+                ++(entries.back().count);
+            }
+            else {
+                SDL_ASSERT(0);
+                complete = false;
+            }
+        }
+    });
+    m_data->for_pg_index([&](schobj_id const id, pageType::type const page_type, pgroot_pgfirst const & value) {
+        add_entry(id, kind_type::pg_index, 0, static_cast<int>(page_type));
+        if (value) {
+            add_page(value.pgroot());
+            add_page(value.pgfirst());
+        }
+    });
+    m_data->for_datapage([&](schobj_id const id, dataType::type const data_type, 
+        pageType::type const page_type, shared_page_head_access const & value) {
+        if (auto const p = dynamic_cast<class_heap_access const *>(value.get())) {
+            add_entry(id, kind_type::heap, static_cast<int>(data_type), static_cast<int>(page_type));
+            for (auto const & r : p->access().runs()) {
+                pageFileID last = r.first;
+                last.pageId += r.count - 1;
+                records.push_back(recordID::init(r.first));
+                records.push_back(recordID::init(last));
+                entries.back().count += 2;
+            }
+        }
+        else if (auto const p = dynamic_cast<class_clustered_access const *>(value.get())) {
+            add_entry(id, kind_type::clustered, static_cast<int>(data_type), static_cast<int>(page_type));
+            add_page(p->access().first_page());
+            add_page(p->access().last_page());
+        }
+        else if (auto const p = dynamic_cast<class_forward_access const *>(value.get())) {
+            add_entry(id, kind_type::forward, static_cast<int>(data_type), static_cast<int>(page_type));
+            add_page(p->access().first_page());
+        }
+    });
+    if (complete) {
+        catalog_sidecar::write(filename(), make_sidecar_key(*this), entries, records);
+    }
+}
 
+void database::warm_index()
+{
     for (auto const & ut : _usertables) {
-        init_datatable(ut);
+        if (auto const index = get_cluster_index(ut)) {
+            if (index->is_root_index()) {
+                for (auto const p : index_tree(this, index).index_pages()) {
+                    PageMapping::touch_page(p);
+                    ++(m_data->open.index_pages);
+                }
+            }
+        }
     }
-    m_data->initialized = true;
 }
 
-void database::init_datatable(shared_usertable const & schema)
+database::open_stat const &
+database::get_open_stat() const
+{
+    return m_data->open;
+}
+
+void database::init_datatable(shared_usertable const & schema) const
 {
-    SDL_ASSERT(!m_data->initialized);
     schobj_id const id = schema->get_id();
     for_dataType([this, id](dataType::type const t){
         this->find_sysalloc(id, t);
@@ -65,11 +495,7 @@ void const * database::start_address() const
 
 void const * database::memory_offset(void const * p) const
 {
-    char const * p1 = (char const *)start_address();
-    char const * p2 = (char const *)p;
-    SDL_ASSERT(p2 >= p1);
-    void const * offset = reinterpret_cast<void const *>(p2 - p1);    
-    return offset;
+    return m_data->pm.memory_offset(p);
 }
 
 size_t database::page_count() const
@@ -77,6 +503,46 @@ size_t database::page_count() const
     return m_data->pm.page_count();
 }
 
+size_t database::file_count() const
+{
+    return m_data->pm.file_count();
+}
+
+void database::advise_pages(pageIndex const first, size_t const count, map_advice const advice) const
+{
+    m_data->pm.advise(first, count, advice);
+}
+
+void database::advise_pages(pageFileID const & first, size_t const count, map_advice const advice) const
+{
+    m_data->pm.advise(first, count, advice);
+}
+
+void database::advise_pages(vector_page_run const & runs, map_advice const advice) const
+{
+    for (auto const & r : runs) {
+        m_data->pm.advise(r.first, r.count, advice);
+    }
+}
+
+void database::advise_pages(page_head const * const first,
+                            page_head const * const last,
+                            map_advice const advice) const
+{
+    SDL_ASSERT(first && last);
+    pageFileID i1 = first->data.pageId;
+    pageFileID i2 = last->data.pageId;
+    if (i1.fileId != i2.fileId) { // range spans data files
+        m_data->pm.advise(i1, 1, advice);
+        m_data->pm.advise(i2, 1, advice);
+        return;
+    }
+    if (i2.pageId < i1.pageId) {
+        std::swap(i1, i2);
+    }
+    m_data->pm.advise(i1, size_t(i2.pageId - i1.pageId) + 1, advice);
+}
+
 page_head const *
 database::load_page_head(pageIndex const i) const
 {
@@ -122,10 +588,40 @@ database::load_page_list(page_head const * p) const
     return vec;
 }
 
+page_head const *
+database::load_resident_head(pageFileID const & id) const
+{
+    return m_data->pm.load_resident(id);
+}
+
+database::page_lock
+database::lock_page(page_head const * const p) const
+{
+    PageMapping const & pm = m_data->pm;
+    if (p && pm.is_pool()) {
+        return page_lock(pm.pin_loaded(p), [&pm](page_head const * const h) {
+            pm.unpin_page(h);
+        });
+    }
+    return page_lock(page_lock(), p); // not owned, nothing to release
+}
+
+database::page_pin::page_pin(database const * const p, pageFileID const & id)
+    : db(p)
+    , head(p->m_data->pm.pin_page(id))
+{
+    SDL_ASSERT(db);
+}
+
+database::page_pin::~page_pin()
+{
+    db->m_data->pm.unpin_page(head);
+}
+
 pageType database::get_pageType(pageFileID const & id) const
 {
-    if (auto p = load_page_head(id)) {
-        SDL_ASSERT(is_allocated(p));
+    if (const page_pin p{this, id}) {
+        SDL_ASSERT(is_allocated(p.get()));
         return p->data.type;
     }
     return pageType::init(pageType::type::null);
@@ -134,7 +630,7 @@ pageType database::get_pageType(pageFileID const & id) const
 bool database::is_pageType(pageFileID const & id, pageType::type const t) const
 {
     SDL_ASSERT(t != pageType::type::null);
-    if (auto p = load_page_head(id)) {
+    if (const page_pin p{this, id}) {
         return p->data.type == t;
     }
     SDL_ASSERT(0);
@@ -143,7 +639,7 @@ bool database::is_pageType(pageFileID const & id, pageType::type const t) const
 
 pageFileID database::nextPageID(pageFileID const & id) const // diagnostic
 {
-    if (auto p = load_page_head(id)) {
+    if (const page_pin p{this, id}) {
         return p->data.nextPage;
     }
     SDL_ASSERT(id.is_null());
@@ -152,7 +648,7 @@ pageFileID database::nextPageID(pageFileID const & id) const // diagnostic
 
 pageFileID database::prevPageID(pageFileID const & id) const // diagnostic
 {
-    if (auto p = load_page_head(id)) {
+    if (const page_pin p{this, id}) {
         return p->data.prevPage;
     }
     SDL_ASSERT(id.is_null());
@@ -162,7 +658,7 @@ pageFileID database::prevPageID(pageFileID const & id) const // diagnostic
 database::page_ptr<bootpage>
 database::get_bootpage() const
 {
-    page_head const * const h = load_page_head(sysPage::boot_page);
+    page_head const * const h = m_data->pm.load_resident(pageIndex(static_cast<pageIndex::value_type>(sysPage::boot_page)));
     if (h) {
         return make_unique<bootpage>(h, cast::page_body<bootpage_row>(h));
     }
@@ -194,7 +690,7 @@ page_head const * database::sysallocunits_head() const
     auto boot = get_bootpage();
     if (boot) {
         auto & id = boot->row->data.dbi_firstSysIndexes;
-        page_head const * const h = m_data->pm.load_page(id);
+        page_head const * const h = load_resident_head(id);
         SDL_ASSERT(h->is_data());
         return h;
     }
@@ -238,7 +734,7 @@ database::load_sys_obj(const sysObj id) const
         }
 #endif
         if (auto row = sysallocunits(h).find_auid(static_cast<uint32>(id))) {
-            return load_page_head(row->data.pgfirst);
+            return load_resident_head(row->data.pgfirst);
         }
     }
     SDL_ASSERT(0);
@@ -251,6 +747,9 @@ page_head const * database::load_next_head(page_head const * const p) const
 {
     if (p) {
         auto next = m_data->pm.load_page(p->data.nextPage);
+        if (next && m_data->prefetch) {
+            m_data->prefetch->next_page(next);
+        }
         SDL_ASSERT(!next || (next->data.type == p->data.type));
         return next;
     }
@@ -258,6 +757,168 @@ page_head const * database::load_next_head(page_head const * const p) const
     return nullptr;
 }
 
+void database::prefetch_heap(page_head const * const p,
+                             std::shared_ptr<vector_page_run const> const & runs,
+                             size_t const run) const
+{
+    if (m_data->prefetch) {
+        m_data->prefetch->heap_page(p, runs, run);
+    }
+}
+
+void database::load_extent(pageFileID const & first, size_t const count) const
+{
+    m_data->pm.load_extent(first, count);
+}
+
+void database::heap_access::advise_scan() const
+{
+    db->advise_pages(data, map_advice::sequential); // pages of other objects may be between runs
+}
+
+void database::clustered_access::advise_scan() const
+{
+    std::call_once(m_runs_once, [this](){
+        m_runs = db->load_page_runs(table_id, dataType::type::IN_ROW_DATA);
+        m_runs_memory = m_runs.capacity() * sizeof(page_run);
+    });
+    db->advise_pages(m_runs, map_advice::sequential);
+}
+
+page_head const *
+database::heap_access::find_page(size_t run, uint32 offset) const
+{
+    for (; run < data.size(); ++run, offset = 0) {
+        page_run const & r = data[run];
+        for (; offset < r.count; ++offset) {
+            pageFileID id = r.first;
+            id.pageId += offset;
+            if (!offset || !(id.pageId % 8)) { // read allocated part of extent with one request
+                uint32 const count = a_min<uint32>(8 - id.pageId % 8, r.count - offset);
+                if (count > 1) {
+                    db->load_extent(id, count);
+                }
+            }
+            if (page_head const * const p = db->load_page_head(id)) {
+                if (p->data.type == page_type) {
+                    db->prefetch_heap(p, m_runs, run);
+                    return p;
+                }
+            }
+            else {
+                SDL_ASSERT(0);
+            }
+        }
+    }
+    return nullptr;
+}
+
+page_head const *
+database::heap_access::next_page(page_head const * const p) const
+{
+    SDL_ASSERT(p);
+    pageFileID const & id = p->data.pageId;
+    auto const it = std::upper_bound(data.begin(), data.end(), id, 
+        [](pageFileID const & x, page_run const & r) {
+        return x < r.first;
+    });
+    if (it != data.begin()) {
+        page_run const & r = *(it - 1); // run of page p
+        SDL_ASSERT(r.first.fileId == id.fileId);
+        SDL_ASSERT(id.pageId - r.first.pageId < r.count);
+        return find_page(it - 1 - data.begin(), id.pageId - r.first.pageId + 1);
+    }
+    SDL_ASSERT(0);
+    return nullptr;
+}
+
+database::pool_stat
+database::get_pool_stat() const
+{
+    pool_stat result;
+    auto const s = m_data->pm.pool_stat();
+    result.hit = s.hit;
+    result.miss = s.miss;
+    result.evicted = s.evicted;
+    result.resident = s.resident;
+    result.pinned = s.pinned;
+    result.frames = s.frames;
+    result.batch_reads = s.batch_reads;
+    return result;
+}
+
+database::vector_heatmap
+database::get_heatmap() const
+{
+    auto const pages = m_data->pm.heatmap(); // before page headers are loaded
+    if (pages.empty()) {
+        return {};
+    }
+    std::map<uint64, sysidxstats_row const *> owner; // allocation unit => index
+    for (auto const & table_idx : m_data->catalog.idxstats) {
+        for (auto const idx : table_idx.second) {
+            if (!idx->data.rowset.is_null()) {
+                for (auto const row : m_data->catalog.find_sysalloc(idx->data.rowset)) {
+                    owner[row->data.auid._64] = idx;
+                }
+            }
+        }
+    }
+    using key_type = std::tuple<uint64, size_t, int>; // auid, level, pageType
+    std::map<key_type, heatmap_entry> group;
+    for (auto const & p : pages) {
+        const page_pin h{this, p.first};
+        if (!h) {
+            SDL_ASSERT(0);
+            continue;
+        }
+        auid_t auid{};
+        auid.d.id = h->data.objId;
+        auid.d.hi = h->data.indexId;
+        const pageType::type type = h->data.type;
+        heatmap_entry & e = group[key_type(auid._64, h->data.level, static_cast<int>(type))];
+        if (!e.pages) {
+            e.auid = auid;
+            e.type = type;
+            e.level = h->data.level;
+            auto const found = owner.find(auid._64);
+            if (found != owner.end()) {
+                e.id = found->second->data.id;
+                e.indid = found->second->data.indid;
+            }
+        }
+        ++e.pages;
+        e.count += p.second;
+    }
+    vector_heatmap result;
+    result.reserve(group.size());
+    for (auto const & g : group) {
+        result.push_back(g.second);
+    }
+    std::sort(result.begin(), result.end(), [](heatmap_entry const & x, heatmap_entry const & y) {
+        return x.count > y.count;
+    });
+    return result;
+}
+
+void database::reset_heatmap() const
+{
+    m_data->pm.reset_heatmap();
+}
+
+database::prefetch_stat
+database::get_prefetch_stat() const
+{
+    prefetch_stat result;
+    if (m_data->prefetch) {
+        auto const s = m_data->prefetch->stat();
+        result.fetched = s.fetched;
+        result.hit = s.hit;
+        result.wasted = s.wasted;
+    }
+    return result;
+}
+
 page_head const * database::load_prev_head(page_head const * const p) const
 {
     if (p) {
@@ -331,66 +992,49 @@ recordID database::load_prev_record(recordID const & r) const
     return{};
 }
 
-template<class fun_type>
-unique_datatable database::find_table_if(fun_type && fun) const
+unique_datatable database::find_table(const std::string & name) const
 {
-    for (auto const & p : _usertables) {
-        const usertable & d = *p.get();
-        if (fun(d)) {
-            return sdl::make_unique<datatable>(this, p);
-        }
+    SDL_ASSERT(!name.empty());
+    auto const found = m_data->catalog.usertable_name.find(name);
+    if (found != m_data->catalog.usertable_name.end()) {
+        return sdl::make_unique<datatable>(this, found->second);
     }
     return {};
 }
 
-template<class fun_type>
-unique_datatable database::find_internal_if(fun_type && fun) const
+unique_datatable database::find_table(schobj_id const id) const
 {
-    for (auto const & p : _internals) {
-        const usertable & d = *p.get();
-        if (fun(d)) {
-            return sdl::make_unique<datatable>(this, p);
-        }
+    auto const found = m_data->catalog.usertable_id.find(id._32);
+    if (found != m_data->catalog.usertable_id.end()) {
+        return sdl::make_unique<datatable>(this, found->second);
     }
     return {};
 }
 
-unique_datatable database::find_table(const std::string & name) const
-{
-    SDL_ASSERT(!name.empty());
-    return find_table_if([&name](const usertable & d) {
-        return d.name() == name;
-    });
-}
-
-unique_datatable database::find_table(schobj_id const id) const
-{
-    return find_table_if([id](const usertable & d) {
-        return d.get_id() == id;
-    });
-}
-
 unique_datatable database::find_internal(const std::string & name) const
 {
     SDL_ASSERT(!name.empty());
-    return find_internal_if([&name](const usertable & d) {
-        return d.name() == name;
-    });
+    auto const found = m_data->catalog.internal_name.find(name);
+    if (found != m_data->catalog.internal_name.end()) {
+        return sdl::make_unique<datatable>(this, found->second);
+    }
+    return {};
 }
 
 unique_datatable database::find_internal(schobj_id const id) const
 {
-    return find_internal_if([id](const usertable & d) {
-        return d.get_id() == id;
-    });
+    auto const found = m_data->catalog.internal_id.find(id._32);
+    if (found != m_data->catalog.internal_id.end()) {
+        return sdl::make_unique<datatable>(this, found->second);
+    }
+    return {};
 }
 
 shared_usertable database::find_table_schema(schobj_id const id) const
 {
-    for (auto const & p : _usertables) {
-        if (p->get_id() == id) {
-            return p;
-        }
+    auto const found = m_data->catalog.usertable_id.find(id._32);
+    if (found != m_data->catalog.usertable_id.end()) {
+        return found->second;
     }
     throw_error<database_error>("cannot find table schema");
     return {};
@@ -398,10 +1042,9 @@ shared_usertable database::find_table_schema(schobj_id const id) const
 
 shared_usertable database::find_internal_schema(schobj_id const id) const
 {
-    for (auto const & p : _internals) {
-        if (p->get_id() == id) {
-            return p;
-        }
+    auto const found = m_data->catalog.internal_id.find(id._32);
+    if (found != m_data->catalog.internal_id.end()) {
+        return found->second;
     }
     throw_error<database_error>("cannot find internal schema");
     return {};
@@ -429,32 +1072,33 @@ template<class fun_type>
 void database::get_tables(vector_shared_usertable & m_ut, fun_type const & is_table) const
 {
     SDL_ASSERT(m_ut.empty());
-    vector_shared_usertable ret;
-    for_row(_sysschobjs, [&ret, &is_table, this](sysschobjs::const_pointer schobj_row){
+    std::vector<sysschobjs_row const *> rows;
+    for_row(_sysschobjs, [&rows, &is_table](sysschobjs::const_pointer schobj_row){
         if (is_table(schobj_row)) {
-            const schobj_id table_id = schobj_row->data.id;
-            usertable::columns cols;
-            for_row(_syscolpars, [&cols, table_id, this](syscolpars::const_pointer colpar_row) {
-                if (colpar_row->data.id == table_id) {
-                    const scalartype utype = colpar_row->data.utype;
-                    if (auto scalar_row = find_if(_sysscalartypes, [utype](sysscalartypes::const_pointer p) {
-                        return (p->data.id == utype);
-                    })) {
-                        usertable::emplace_back(cols, colpar_row, scalar_row);
-                    }
-                }
-            });
-            if (!cols.empty()) {
-                primary_key const * const PK = get_primary_key(table_id).get();             
-                auto ut = std::make_shared<usertable>(schobj_row, std::move(cols), PK);
-                SDL_ASSERT(schobj_row->data.id == ut->get_id());
-                ret.push_back(std::move(ut));
+            rows.push_back(schobj_row);
+        }
+    });
+    vector_shared_usertable ret(rows.size());
+    parallel_for(rows.size(), m_data->init_threads, [&rows, &ret, this](size_t const i){
+        sysschobjs_row const * const schobj_row = rows[i];
+        const schobj_id table_id = schobj_row->data.id;
+        usertable::columns cols;
+        for (auto const colpar_row : m_data->catalog.find_colpars(table_id)) {
+            SDL_ASSERT(colpar_row->data.id == table_id);
+            if (auto scalar_row = m_data->catalog.find_scalartype(colpar_row->data.utype)) {
+                usertable::emplace_back(cols, colpar_row, scalar_row);
             }
         }
+        if (!cols.empty()) {
+            primary_key const * const PK = get_primary_key(table_id).get();             
+            ret[i] = std::make_shared<usertable>(schobj_row, std::move(cols), PK);
+            SDL_ASSERT(schobj_row->data.id == ret[i]->get_id());
+        }
     });
+    ret.erase(std::remove(ret.begin(), ret.end(), nullptr), ret.end()); // tables without columns
     if (!ret.empty()) {
         using table_type = vector_shared_usertable::value_type;
-        std::sort(ret.begin(), ret.end(),
+        std::stable_sort(ret.begin(), ret.end(), // deterministic for any number of threads
             [](table_type const & x, table_type const & y){
             return x->name() < y->name();
         });    
@@ -493,28 +1137,62 @@ database::get_internals() const
     return ut;
 }
 
-database::shared_datatables
-database::get_datatables() const
+shared_datatable const &
+database::datatable_access::operator[](size_t const i) const
+{
+    SDL_ASSERT(i < size());
+    slot_type & slot = slots[i];
+    std::call_once(slot.once, [this, &slot, i](){
+        slot.table = std::make_shared<datatable>(db, (*tables)[i]);
+    });
+    return slot.table;
+}
+
+size_t database::datatable_access::find_pos(const std::string & name) const
 {
-    if (!m_data->empty_datatable()) {
-        return m_data->datatable();
+    if (tables) {
+        auto const found = std::lower_bound(tables->begin(), tables->end(), name,
+            [](shared_usertable const & x, const std::string & y){
+            return x->name() < y;
+        });
+        if ((found != tables->end()) && ((*found)->name() == name)) {
+            return found - tables->begin();
+        }
     }
-    SDL_ASSERT(!m_data->initialized);
-    auto const ut = this->get_usertables();
-    shared_datatables dt(new vector_shared_datatable);
-    dt->reserve(ut->size());
+    return size();
+}
 
-    for (auto & p : *ut) {
-        dt->push_back(std::make_shared<datatable>(this, p));
+shared_datatable
+database::datatable_access::find(const std::string & name) const
+{
+    SDL_ASSERT(!name.empty());
+    size_t const i = find_pos(name);
+    if (i < size()) {
+        return (*this)[i];
     }
-    using table_type = vector_shared_datatable::value_type;
-    std::sort(dt->begin(), dt->end(),
-        [](table_type const & x, table_type const & y){
-        return x->name() < y->name();
-    });
+    return {};
+}
 
-    m_data->datatable() = dt;
-    return dt;
+size_t database::preload(std::vector<std::string> const & names) const
+{
+    std::vector<size_t> pos; // positions in _datatables
+    if (names.empty()) {
+        pos.resize(_datatables.size());
+        std::iota(pos.begin(), pos.end(), size_t(0));
+    }
+    else {
+        for (auto const & name : names) {
+            size_t const i = _datatables.find_pos(name);
+            if (i < _datatables.size()) {
+                pos.push_back(i);
+            }
+        }
+    }
+    parallel_for(pos.size(), m_data->init_threads, [this, &pos](size_t const i){
+        _datatables[pos[i]]->get_index_tree(); // resolve metadata
+        init_datatable((*_datatables.tables)[pos[i]]);
+    });
+    return pos.size();
 }
 
 database::shared_sysallocunits
@@ -528,26 +1206,22 @@ database::find_sysalloc(schobj_id const id, dataType::type const data_type) cons
     }
     shared_sysallocunits shared_result(new vector_sysallocunits_row);
     auto & result = *shared_result;
-    for_row(_sysidxstats, [this, id, data_type, &result](sysidxstats::const_pointer idx) {
-        if ((idx->data.id == id) && !idx->data.rowset.is_null()) {
-            for_row(_sysallocunits, 
-                [this, idx, data_type, &result](sysallocunits::const_pointer row) {
-                    if (row->data.pgfirstiam) {
-                        if ((row->data.ownerid == idx->data.rowset) && (row->data.type == data_type)) {
-                            if (!algo::is_find(result, row)) {
-                                result.push_back(row);
-                            }
-                            else {
-                                SDL_ASSERT(!"push unique"); // to be tested
-                            }
-                        }
+    for (auto const idx : m_data->catalog.find_idxstats(id)) {
+        SDL_ASSERT(idx->data.id == id);
+        if (!idx->data.rowset.is_null()) {
+            for (auto const row : m_data->catalog.find_sysalloc(idx->data.rowset)) {
+                SDL_ASSERT(row->data.ownerid == idx->data.rowset);
+                if (row->data.pgfirstiam && (row->data.type == data_type)) {
+                    if (!algo::is_find(result, row)) {
+                        result.push_back(row);
                     }
                     else {
-                        //SDL_TRACE("\nfind_sysalloc id=", idx->data.id._32, " name=", col_name_t(idx));
+                        SDL_ASSERT(!"push unique"); // to be tested
                     }
-            });
+                }
+            }
         }
-    });
+    }
     m_data->set_sysalloc(id, data_type, shared_result);
     return shared_result;
 }
@@ -568,9 +1242,9 @@ database::load_pg_index(schobj_id const id, pageType::type const page_type) cons
         SDL_ASSERT(alloc->data.pgfirstiam);
         if (alloc->data.pgroot && alloc->data.pgfirst) { // root page of the index tree
             if (is_allocated(alloc->data.pgroot) && is_allocated(alloc->data.pgfirst)) { // it is possible that pgfirst is not allocated (and not empty)
-                auto const pgroot = load_page_head(alloc->data.pgroot); // load index page
+                auto const pgroot = load_resident_head(alloc->data.pgroot); // load index page
                 if (pgroot) {
-                    auto const pgfirst = load_page_head(alloc->data.pgfirst); // ask for data page
+                    auto const pgfirst = load_resident_head(alloc->data.pgfirst); // ask for data page
                     SDL_ASSERT(pgfirst);
                     if (pgfirst && (pgfirst->data.type == page_type)) {
                         if (pgroot->is_index()) {
@@ -613,10 +1287,10 @@ database::find_datapage(schobj_id const id,
         if (auto const index = get_cluster_index(id)) { // use cluster index if possible
             if (index->is_root_index()) {
                 const index_tree tree(this, index);
-                page_head const * const min_page = load_page_head(tree.min_page());
-                page_head const * const max_page = load_page_head(tree.max_page());
+                page_head const * const min_page = load_resident_head(tree.min_page());
+                page_head const * const max_page = load_resident_head(tree.max_page());
                 if (min_page && max_page) {
-                    reset_shared<class_clustered_access>(result, this, min_page, max_page);
+                    reset_shared<class_clustered_access>(result, this, id, min_page, max_page);
                     m_data->set_datapage(id, data_type, page_type, result);
                     return result;
                 }
@@ -633,43 +1307,327 @@ database::find_datapage(schobj_id const id,
         }
     }
     // Heap tables won't have root pages
-    vector_page_head heap_pages;
+    // Page headers are not read here: page type is checked when heap is scanned
+    reset_shared<class_heap_access>(result, this, load_page_runs(id, data_type), page_type);
+    m_data->set_datapage(id, data_type, page_type, result);
+    return result;
+}
+
+database::vector_page_run
+database::load_page_runs(schobj_id const id, dataType::type const data_type) const
+{
+    vector_page_run runs;
     vector_sysallocunits_row const & sysalloc = *find_sysalloc(id, data_type);
     for (auto alloc : sysalloc) {
         A_STATIC_CHECK_TYPE(sysallocunits_row const *, alloc);
         SDL_ASSERT(alloc->data.type == data_type);
         for (auto const & page : iam_access(this, alloc)) {
             A_STATIC_CHECK_TYPE(shared_iam_page const &, page);
-            page->allocated_pages(this, [this, page_type, &heap_pages](pageFileID const & id) {
-                SDL_ASSERT(id);
-                if (auto p = this->load_page_head(id)) {
-                    if (p->data.type == page_type) {
-                        heap_pages.push_back(p);
-                    }
+            page->allocated_pages(this, [&runs](pageFileID const & id) {
+                append_page_run(runs, id);
+            });
+        }
+    }
+    sort_page_runs(runs);
+    return runs;
+}
+
+database::table_size
+database::get_table_size(schobj_id const id) const
+{
+    table_size result;
+    for (auto const idx : m_data->catalog.find_idxstats(id)) {
+        SDL_ASSERT(idx->data.id == id);
+        if ((idx->data.indid._32 > 1) || idx->data.rowset.is_null()) {
+            continue; // nonclustered index
+        }
+        if (sysrowsets_row const * const row = m_data->catalog.find_rowset(idx->data.rowset)) {
+            result.rows += row->data.rcrows;
+        }
+        for (auto const alloc : m_data->catalog.find_sysalloc(idx->data.rowset)) {
+            if (alloc->data.type == dataType::type::IN_ROW_DATA) {
+                result.data_pages += alloc->data.pcdata;
+                result.used_pages += alloc->data.pcused;
+                result.reserved_pages += alloc->data.pcreserved;
+            }
+        }
+    }
+    return result;
+}
+
+database::vector_page_run
+database::load_page_chunks(schobj_id const id, dataType::type const type) const
+{
+    enum { chunk_pages = 64 }; // 8 extents are read by one task
+    vector_page_run chunks;
+    for (auto const & r : load_page_runs(id, type)) {
+        page_run chunk = r;
+        while (chunk.count) {
+            uint32 const count = a_min<uint32>(chunk.count, chunk_pages - chunk.first.pageId % chunk_pages);
+            chunks.push_back({ chunk.first, count });
+            chunk.first.pageId += count;
+            chunk.count -= count;
+        }
+    }
+    return chunks;
+}
+
+size_t database::count_rows(schobj_id const id, row_count const mode) const
+{
+    vector_page_run const chunks = load_page_chunks(id, dataType::type::IN_ROW_DATA);
+    std::vector<size_t> count(chunks.size());
+    parallel_for(chunks.size(), m_data->init_threads, [this, mode, &chunks, &count](size_t const i){
+        page_run const & chunk = chunks[i];
+        if (chunk.count > 1) {
+            load_extent(chunk.first, chunk.count);
+        }
+        size_t result = 0;
+        pageFileID id = chunk.first;
+        for (uint32 j = 0; j < chunk.count; ++j, ++id.pageId) {
+            if (!is_allocated(id)) {
+                continue;
+            }
+            if (const page_pin h{this, id}) {
+                if (h->data.type != pageType::type::data) {
+                    continue;
+                }
+                if (mode == row_count::slots) {
+                    result += slot_array(h.get()).size();
                 }
                 else {
-                    SDL_ASSERT(0);
+                    const datapage page(h.get());
+                    for (size_t slot = 0; slot < page.size(); ++slot) {
+                        row_head const * const row = page[slot];
+                        if (row && row->use_record()) {
+                            ++result;
+                        }
+                    }
                 }
-            });
+            }
         }
+        count[i] = result;
+    });
+    return std::accumulate(count.begin(), count.end(), size_t(0));
+}
+
+bool database::is_same_page(database const & old, pageFileID const & id) const
+{
+    if (id.is_null()) {
+        return false;
     }
-    if (1) {
-        std::sort(heap_pages.begin(), heap_pages.end(), 
-            [](page_head const * x, page_head const * y){
-            return (x->data.pageId < y->data.pageId);
-        });
+    try {
+        if ((id.pageId < m_data->pm.page_count(id.fileId)) && 
+            (id.pageId < old.m_data->pm.page_count(id.fileId))) {
+            const page_pin p1{this, id};
+            const page_pin p2{&old, id};
+            if (p1 && p2) {
+                return 0 == ::memcmp(p1.get(), p2.get(), page_head::page_size);
+            }
+        }
+    }
+    catch (sdl_exception &) { // data file is missing in one of versions
+    }
+    return false;
+}
+
+bool database::is_same_sysalloc(database const & old, schobj_id const id, dataType::type const data_type) const
+{
+    vector_sysallocunits_row const & s1 = *find_sysalloc(id, data_type);
+    vector_sysallocunits_row const & s2 = *old.find_sysalloc(id, data_type);
+    if (s1.size() != s2.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < s1.size(); ++i) {
+        if (::memcmp(s1[i], s2[i], sizeof(sysallocunits_row))) {
+            return false;
+        }
+        for (auto const & page : iam_access(this, s1[i])) {
+            if (!is_same_page(old, page->head->data.pageId)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+size_t database::shared_data::catalog_type::memory_size() const
+{
+    return hash_memory_size(idxstats)
+        + hash_memory_size(sysalloc)
+        + hash_memory_size(colpars)
+        + hash_memory_size(iscols)
+        + hash_memory_size(scalartypes)
+        + hash_memory_size(rowsets)
+        + hash_memory_size(usertable_name)
+        + hash_memory_size(usertable_id)
+        + hash_memory_size(internal_name)
+        + hash_memory_size(internal_id);
+}
+
+database::memory_report
+database::memory_usage() const
+{
+    using shared_data = database::shared_data;
+    std::map<schobj_id::type, memory_stat> table;
+    m_data->for_sysalloc([&table](schobj_id const id, dataType::type, shared_sysallocunits const & value) {
+        table[id._32].sysalloc += shared_data::memory_size(value);
+    });
+    m_data->for_datapage([&table](schobj_id const id, dataType::type, pageType::type, shared_page_head_access const & value) {
+        table[id._32].datapage += shared_data::memory_size(value);
+    });
+    m_data->for_pg_index([&table](schobj_id const id, pageType::type, pgroot_pgfirst const &) {
+        table[id._32].pg_index += sizeof(std::pair<schobj_id, pgroot_pgfirst>);
+    });
+    m_data->for_primary_key([&table](schobj_id const id, shared_primary_key const & value) {
+        size_t & bytes = table[id._32].primary;
+        bytes += sizeof(std::pair<schobj_id, shared_primary_key>);
+        if (value) {
+            bytes += sizeof(primary_key)
+                + value->colpar.capacity() * sizeof(syscolpars_row const *)
+                + value->scalar.capacity() * sizeof(sysscalartypes_row const *)
+                + value->order.capacity() * sizeof(sortorder);
+        }
+    });
+    m_data->for_cluster_index([&table](schobj_id const id, shared_cluster_index const & value) {
+        size_t & bytes = table[id._32].cluster;
+        bytes += sizeof(std::pair<schobj_id, shared_cluster_index>);
+        if (value) {
+            bytes += sizeof(cluster_index) + 2 * value->size() * sizeof(size_t); // column index, sub-key length
+        }
+    });
+    m_data->for_nonclustered([&table](schobj_id const id, shared_vector_nonclustered const & value) {
+        size_t & bytes = table[id._32].cluster;
+        bytes += sizeof(std::pair<schobj_id, shared_vector_nonclustered>);
+        if (value) {
+            bytes += sizeof(vector_nonclustered_index) + value->capacity() * sizeof(shared_nonclustered_index);
+            for (auto const & p : *value) {
+                bytes += sizeof(nonclustered_index) + sizeof(key_compare)
+                    + p->size() * (3 * sizeof(size_t) + sizeof(sortorder)); // column index, sub-key length, compare
+            }
+        }
+    });
+    m_data->for_spatial_tree([&table](schobj_id const id, spatial_tree_idx const &) {
+        table[id._32].spatial_tree += sizeof(std::pair<schobj_id, spatial_tree_idx>);
+    });
+    m_data->for_index_cache([&table](schobj_id const id, shared_index_cache const & value) {
+        size_t & bytes = table[id._32].index_cache;
+        bytes += sizeof(std::pair<schobj_id, shared_index_cache>);
+        if (value) {
+            bytes += sizeof(index_cache) + value->memory_size();
+        }
+    });
+    m_data->for_key_filter([&table](schobj_id const id, shared_key_filter const & value) {
+        size_t & bytes = table[id._32].key_filter;
+        bytes += sizeof(std::pair<schobj_id, shared_key_filter>);
+        if (value) {
+            bytes += sizeof(key_filter) + value->memory_size();
+        }
+    });
+    memory_report result;
+    result.table.reserve(table.size());
+    for (auto const & p : table) {
+        memory_stat const & s = p.second;
+        result.total.sysalloc += s.sysalloc;
+        result.total.datapage += s.datapage;
+        result.total.pg_index += s.pg_index;
+        result.total.primary += s.primary;
+        result.total.cluster += s.cluster;
+        result.total.spatial_tree += s.spatial_tree;
+        result.total.index_cache += s.index_cache;
+        result.total.key_filter += s.key_filter;
+        table_memory t;
+        t.id._32 = p.first;
+        t.stat = s;
+        result.table.push_back(t);
+    }
+    std::stable_sort(result.table.begin(), result.table.end(), [](table_memory const & x, table_memory const & y) {
+        return x.stat.heap() > y.stat.heap();
+    });
+    result.total.catalog = m_data->catalog.memory_size();
+    if (m_data->pfs) {
+        result.total.pfs = m_data->pfs->memory_size();
+    }
+    result.total.pool = m_data->pm.pool_stat().frames * page_head::page_size;
+    result.mapped = m_data->pm.resident_size();
+    result.evicted = m_data->evicted();
+    return result;
+}
+
+database::carry_stat
+database::carry_cache(database const & old)
+{
+    using class_heap_access = page_head_access_t<heap_access>;
+    struct entry_type {
+        schobj_id id;
+        dataType::type data_type;
+        pageType::type page_type;
+        shared_page_head_access value;
+    };
+    std::vector<entry_type> entries;
+    old.m_data->for_datapage([&entries](schobj_id const id, 
+        dataType::type const data_type,
+        pageType::type const page_type,
+        shared_page_head_access const & value) {
+        entries.push_back({ id, data_type, page_type, value });
+    });
+    auto const is_table = [this](schobj_id const id) {
+        return m_data->catalog.usertable_id.count(id._32) || m_data->catalog.internal_id.count(id._32);
+    };
+    std::map<pageFileID, bool> same_pfs; // PFS page => identical in both versions
+    carry_stat result;
+    for (auto const & e : entries) {
+        if (!is_table(e.id) || m_data->find_datapage(e.id, e.data_type, e.page_type).second) {
+            continue; // object is dropped or entry is built already
+        }
+        if (auto const heap = dynamic_cast<class_heap_access const *>(e.value.get())) {
+            if (is_same_sysalloc(old, e.id, e.data_type)) {
+                vector_page_run const & old_runs = heap->access().runs();
+                bool same = true;
+                for (auto const & r : old_runs) { // every PFS interval of the run
+                    uint32 const last = r.first.pageId + r.count - 1;
+                    pageFileID pageId = r.first;
+                    while (same) {
+                        pageFileID const pfs = pfs_page::pfs_for_page(pageId);
+                        auto found = same_pfs.find(pfs);
+                        if (found == same_pfs.end()) {
+                            found = same_pfs.emplace(pfs, is_same_page(old, pfs)).first;
+                        }
+                        same = found->second;
+                        uint32 const next = (pageId.pageId / pfs_page_row::pfs_size + 1) * pfs_page_row::pfs_size;
+                        if (next > last) {
+                            break;
+                        }
+                        pageId.pageId = next;
+                    }
+                    if (!same) {
+                        break;
+                    }
+                }
+                if (same) {
+                    vector_page_run heap_runs(old_runs);
+                    shared_page_head_access value;
+                    reset_shared<class_heap_access>(value, this, std::move(heap_runs), heap->access().type());
+                    m_data->set_datapage(e.id, e.data_type, e.page_type, value);
+                    ++result.carried;
+                    continue;
+                }
+            }
+        }
+        find_datapage(e.id, e.data_type, e.page_type);
+        ++result.rebuilt;
     }
-    reset_shared<class_heap_access>(result, this, std::move(heap_pages));
-    m_data->set_datapage(id, data_type, page_type, result);
     return result;
 }
 
 bool database::is_allocated(pageFileID const & id) const
 {
     if (!id.is_null()) {
-        if (id.pageId < (uint32)page_count()) { // check range
-            if (auto h = load_page_head(pfs_page::pfs_for_page(id))) {
-                return pfs_page(h)[id].b.allocated;
+        if (id.pageId < (uint32)m_data->pm.page_count(id.fileId)) { // check range
+            if (m_data->pfs) {
+                return m_data->pfs->is_allocated(id);
+            }
+            if (const page_pin h{this, pfs_page::pfs_for_page(id)}) {
+                return pfs_page(h.get())[id].b.allocated;
             }
         }
         else {
@@ -687,6 +1645,31 @@ bool database::is_allocated(page_head const * const p) const
      return false;
 }
 
+pfs_byte database::get_pfs_byte(pageFileID const & id) const
+{
+    if (m_data->pfs) {
+        return m_data->pfs->get(id);
+    }
+    return {};
+}
+
+database::vector_page_range
+database::allocated_ranges() const
+{
+    if (m_data->pfs) {
+        return m_data->pfs->allocated_ranges();
+    }
+    return {};
+}
+
+size_t database::allocated_count() const
+{
+    if (m_data->pfs) {
+        return m_data->pfs->allocated_count();
+    }
+    return 0;
+}
+
 shared_iam_page database::load_iam_page(pageFileID const & id) const
 {
     if (is_allocated(id)) {
@@ -708,20 +1691,20 @@ database::get_primary_key(schobj_id const table_id) const
     }
     shared_primary_key result;
     if (auto const pg = load_pg_index(table_id, pageType::type::data)) {
-        sysidxstats_row const * idx = 
-            find_if(_sysidxstats, [table_id](sysidxstats::const_pointer p) {
-                if ((p->data.id == table_id) && p->data.indid.is_clustered()) {
-                    return p->data.status.IsPrimaryKey();
+        auto const & table_idx = m_data->catalog.find_idxstats(table_id);
+        auto const find_clustered = [&table_idx](bool const primary) -> sysidxstats_row const * {
+            for (auto const p : table_idx) {
+                if (p->data.indid.is_clustered()) {
+                    if (primary ? p->data.status.IsPrimaryKey() : p->data.status.IsUnique()) {
+                        return p;
+                    }
                 }
-                return false;
-            });
+            }
+            return nullptr;
+        };
+        sysidxstats_row const * idx = find_clustered(true);
         if (!idx) {
-            idx = find_if(_sysidxstats, [table_id](sysidxstats::const_pointer p) {
-                if ((p->data.id == table_id) && p->data.indid.is_clustered()) {
-                    return p->data.status.IsUnique();
-                }
-                return false;
-            });
+            idx = find_clustered(false);
         }
         if (idx) {
             SDL_ASSERT(idx->data.status.IsPrimaryKey() || idx->data.status.IsUnique());
@@ -729,11 +1712,11 @@ database::get_primary_key(schobj_id const table_id) const
             SDL_ASSERT(idx->data.indid.is_clustered());            
             
             std::vector<sysiscols_row const *> idx_stat;
-            for_row(_sysiscols, [table_id, idx, &idx_stat](sysiscols::const_pointer stat) {
-                if ((stat->data.idmajor == table_id) && (stat->data.idminor == idx->data.indid)) {
+            for (auto const stat : m_data->catalog.find_iscols(table_id)) {
+                if (stat->data.idminor == idx->data.indid) {
                     idx_stat.push_back(stat);
                 }
-            });
+            }
             if (!idx_stat.empty()) {
                 SDL_ASSERT(idx_stat.size() < 256); // we use sysiscols_row.tinyprop1 (1 byte) to sort columns
                 std::sort(idx_stat.begin(), idx_stat.end(), 
@@ -751,15 +1734,15 @@ database::get_primary_key(schobj_id const table_id) const
                 idx_ord.reserve(idx_stat.size());
                 for (sysiscols_row const * stat : idx_stat) {
                     SDL_ASSERT(stat->data.status.is_index());
-                    if (syscolpars_row const * const col = find_if(_syscolpars, 
-                        [table_id, stat](syscolpars::const_pointer p) {
-                            return (p->data.id == table_id) && (p->data.colid == stat->data.intprop);
-                        }))
+                    auto const & table_col = m_data->catalog.find_colpars(table_id);
+                    auto const found_col = std::find_if(table_col.begin(), table_col.end(),
+                        [stat](syscolpars_row const * p) {
+                            return p->data.colid == stat->data.intprop;
+                        });
+                    if (found_col != table_col.end())
                     {
-                        const scalartype utype = col->data.utype;
-                        if (auto scal = find_if(_sysscalartypes, [utype](sysscalartypes::const_pointer p) {
-                            return (p->data.id == utype);
-                        })) 
+                        syscolpars_row const * const col = *found_col;
+                        if (auto scal = m_data->catalog.find_scalartype(col->data.utype)) 
                         {
                             if (usertable::column::is_fixed(col, scal)) {
                                 idx_col.push_back(col);
@@ -847,6 +1830,106 @@ database::get_cluster_index(schobj_id const id) const
     return{};
 }
 
+shared_index_cache
+database::get_index_cache(shared_cluster_index const & index) const
+{
+    if (!(m_data->use_index_cache && index && index->is_root_index())) {
+        return {};
+    }
+    schobj_id const id = index->get_id();
+    {
+        auto const found = m_data->find_index_cache(id);
+        if (found.second) {
+            return found.first;
+        }
+    }
+    shared_index_cache const result = index_tree(this, index).make_cache();
+    m_data->set_index_cache(id, result);
+    return result;
+}
+
+shared_key_filter
+database::get_key_filter(datatable const & table) const
+{
+    shared_cluster_index const & index = table.get_cluster_index();
+    if (!(m_data->use_key_filter && index && index->is_root_index())) {
+        return {};
+    }
+    schobj_id const id = table.get_id();
+    {
+        auto const found = m_data->find_key_filter(id);
+        if (found.second) {
+            return found.first;
+        }
+    }
+    shared_key_filter result;
+    if (m_data->key_filter_sidecar) {
+        result = key_filter::load(filename(), id, make_sidecar_key(*this));
+    }
+    if (!result) {
+        try {
+            result = make_key_filter(table);
+        }
+        catch (sdl_exception & e) { // cluster key is not read from record
+            (void)e;
+            SDL_TRACE("key_filter: ", e.what());
+        }
+        if (result && m_data->key_filter_sidecar) {
+            result->write(filename(), id, make_sidecar_key(*this));
+        }
+    }
+    m_data->set_key_filter(id, result);
+    return result;
+}
+
+shared_key_filter
+database::make_key_filter(datatable const & table) const
+{
+    cluster_index const & index = *table.get_cluster_index();
+    vector_page_run const chunks = load_page_chunks(table.get_id(), dataType::type::IN_ROW_DATA);
+    std::vector<std::vector<uint64>> hash(chunks.size()); // keys are hashed by init_threads
+    parallel_for(chunks.size(), m_data->init_threads, [this, &table, &index, &chunks, &hash](size_t const i){
+        page_run const & chunk = chunks[i];
+        if (chunk.count > 1) {
+            load_extent(chunk.first, chunk.count);
+        }
+        std::vector<uint64> & result = hash[i];
+        pageFileID id = chunk.first;
+        for (uint32 j = 0; j < chunk.count; ++j, ++id.pageId) {
+            if (!is_allocated(id)) {
+                continue;
+            }
+            if (const page_pin h{this, id}) {
+                if (h->data.type != pageType::type::data) {
+                    continue;
+                }
+                const datapage page(h.get());
+                for (size_t slot = 0; slot < page.size(); ++slot) {
+                    row_head const * const row = page[slot];
+                    if (row && row->use_record()) {
+                        result.push_back(key_filter::hash(
+                            datatable::record_type(&table, row).get_cluster_key(index)));
+                    }
+                }
+            }
+        }
+    });
+    size_t count = 0;
+    for (auto const & v : hash) {
+        count += v.size();
+    }
+    if (!key_filter::is_enough(count, m_data->key_filter_limit)) {
+        return {};
+    }
+    auto result = std::make_shared<key_filter>(count, m_data->key_filter_limit);
+    for (auto const & v : hash) {
+        for (uint64 const h : v) {
+            result->insert(h);
+        }
+    }
+    return result;
+}
+
 page_head const *
 database::get_cluster_root(schobj_id const id) const
 {
@@ -935,6 +2018,121 @@ database::var_data(row_head const * const row, size_t const i, scalartype::type
     return {};
 }
 
+shared_vector_nonclustered
+database::get_nonclustered(shared_usertable const & schema) const
+{
+    if (!schema) {
+        SDL_ASSERT(0);
+        return std::make_shared<vector_nonclustered_index>();
+    }
+    schobj_id const table_id = schema->get_id();
+    {
+        auto const found = m_data->find_nonclustered(table_id);
+        if (found.second) {
+            return found.first;
+        }
+    }
+    auto result = std::make_shared<vector_nonclustered_index>();
+    for (auto const idx : index_for_table(table_id)) {
+        if (idx->data.type == idxtype::nonclustered) {
+            if (auto p = make_nonclustered(schema, idx)) {
+                result->push_back(std::move(p));
+            }
+            else {
+                SDL_TRACE("nonclustered index not supported: ", schema->name(), ".", col_name_t(idx));
+            }
+        }
+    }
+    m_data->set_nonclustered(table_id, result);
+    return result;
+}
+
+shared_nonclustered_index
+database::make_nonclustered(shared_usertable const & schema, sysidxstats_row const * const idx) const
+{
+    SDL_ASSERT(idx->data.type == idxtype::nonclustered);
+    if (idx->data.status.IsDisabled() || idx->data.status.IsHypothetical() || idx->data.status.HasFilter()) {
+        return {}; // filtered index does not have all rows
+    }
+    schobj_id const table_id = schema->get_id();
+    shared_cluster_index cluster;
+    for (auto const p : m_data->catalog.find_idxstats(table_id)) {
+        if (p->data.indid.is_clustered()) {
+            cluster = get_cluster_index(schema);
+            if (!cluster) {
+                return {}; // locator of non-unique clustered index has uniquifier
+            }
+            for (size_t i = 0; i < cluster->size(); ++i) {
+                if (!nonclustered_index::is_key_column((*cluster)[i])) {
+                    return {}; // locator is read at fixed offsets
+                }
+            }
+            break;
+        }
+    }
+    std::vector<sysiscols_row const *> idx_stat;
+    for (auto const stat : m_data->catalog.find_iscols(table_id)) {
+        if (stat->data.idminor == idx->data.indid) {
+            if (!stat->data.status.is_index()) {
+                return {}; // included columns are not supported
+            }
+            idx_stat.push_back(stat);
+        }
+    }
+    if (idx_stat.empty()) {
+        return {};
+    }
+    std::sort(idx_stat.begin(), idx_stat.end(),
+        [](sysiscols_row const * x, sysiscols_row const * y) {
+        return x->data.tinyprop1 < y->data.tinyprop1;
+    });
+    nonclustered_index::column_index pos;
+    nonclustered_index::column_order ord;
+    pos.reserve(idx_stat.size());
+    ord.reserve(idx_stat.size());
+    auto const & table_col = m_data->catalog.find_colpars(table_id);
+    for (sysiscols_row const * stat : idx_stat) {
+        auto const found_col = std::find_if(table_col.begin(), table_col.end(),
+            [stat](syscolpars_row const * p) {
+                return p->data.colid == stat->data.intprop;
+            });
+        if (found_col == table_col.end()) {
+            SDL_ASSERT(!"_syscolpars");
+            return {};
+        }
+        auto const col = schema->find_col(*found_col);
+        if (!col.first) {
+            SDL_ASSERT(!"find_col");
+            return {};
+        }
+        if (!nonclustered_index::is_key_column(*col.first)) {
+            return {}; // variable length key column: no index, SEEK_INDEX scans table
+        }
+        pos.push_back(col.second);
+        ord.push_back(stat->data.status.index_order());
+    }
+    page_head const * root = nullptr;
+    page_head const * first = nullptr; // first leaf page
+    for (auto const alloc : m_data->catalog.find_sysalloc(idx->data.rowset)) {
+        if ((alloc->data.type == dataType::type::IN_ROW_DATA) && alloc->data.pgroot && alloc->data.pgfirst) {
+            if (is_allocated(alloc->data.pgroot) && is_allocated(alloc->data.pgfirst)) {
+                root = load_resident_head(alloc->data.pgroot);
+                first = load_resident_head(alloc->data.pgfirst);
+                break;
+            }
+        }
+    }
+    if (!(root && first && root->is_index() && slot_array::size(root))) {
+        return {};
+    }
+    auto result = std::make_shared<nonclustered_index>(idx, root, schema, std::move(pos), std::move(ord), cluster);
+    size_t const pminlen = root->data.level ? result->node_length() : result->leaf_length();
+    if ((root->data.pminlen != pminlen) || (first->data.pminlen != result->leaf_length())) {
+        return {}; // unexpected row layout
+    }
+    return result;
+}
+
 geo_mem database::get_geography(row_head const * const row, size_t const i) const
 {
     return geo_mem(this->var_data(row, i, scalartype::t_geography));
@@ -945,8 +2143,8 @@ database::index_for_table(schobj_id const id) const
 {
     using T = vector_sysidxstats_row;
     T result;
-    for_row(_sysidxstats, [this, id, &result](sysidxstats::const_pointer idx) {
-        if ((idx->data.id == id) && idx->data.indid.is_index()) {
+    for (auto const idx : m_data->catalog.find_idxstats(id)) {
+        if (idx->data.indid.is_index()) {
             switch (idx->data.type) {
             case idxtype::clustered:
             case idxtype::nonclustered:
@@ -957,7 +2155,7 @@ database::index_for_table(schobj_id const id) const
                 break; // _WA_Sys_00000002_182C9B23 (used for statistics)
             }
         }
-    });
+    }
     std::sort(result.begin(), result.end(),
         [](T::value_type const & x, T::value_type const & y){
         return x->data.indid < y->data.indid;
@@ -1002,16 +2200,11 @@ database::find_spatial_alloc(const std::string & index_name) const
 
 sysidxstats_row const * database::find_spatial_idx(schobj_id const table_id) const
 {
-    sysidxstats_row const * const idx = 
-    find_if(_sysidxstats, [this, table_id](sysidxstats::const_pointer idx) {
-        if ((idx->data.type == idxtype::spatial) && (idx->data.id == table_id)) {
-            return true;
+    for (auto const idx : m_data->catalog.find_idxstats(table_id)) {
+        if (idx->data.type == idxtype::spatial) {
+            SDL_ASSERT(idx->data.id == table_id);
+            return idx;
         }
-        return false;
-    });
-    if (idx) {
-        SDL_ASSERT(idx->data.id == table_id);
-        return idx;
     }
     return nullptr;
 }
@@ -1052,7 +2245,7 @@ database::find_spatial_tree(schobj_id const table_id) const
             if (auto const pk0 = get_primary_key(table_id)) {
                 if (1 == pk0->size()) {
                     if (pk0->is_index()) {
-                        if (auto const pgroot = load_page_head(root->data.pgroot)) {
+                        if (auto const pgroot = load_resident_head(root->data.pgroot)) {
                             result.pgroot = pgroot;
                             result.idx = sroot.second;
                             m_data->set_spatial_tree(table_id, result);
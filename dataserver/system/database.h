@@ -5,6 +5,9 @@
 #define __SDL_SYSTEM_DATABASE_H__
 
 #include "datatable.h"
+#include "database_param.h"
+#include "filesys/file_map.h"
+#include <mutex>
 
 namespace sdl { namespace db {
 
@@ -37,11 +40,11 @@ public:
 
     using vector_sysallocunits_row = std::vector<sysallocunits_row const *>;
     using vector_page_head = std::vector<page_head const *>;
+    using vector_page_run = std::vector<page_run>;
     using page_head_access = datatable::page_head_access;
     using shared_sysallocunits = std::shared_ptr<vector_sysallocunits_row>;
     using shared_page_head_access = std::shared_ptr<page_head_access>;
     using shared_usertables = std::shared_ptr<vector_shared_usertable>;
-    using shared_datatables = std::shared_ptr<vector_shared_datatable>;
 
 public: // for page_iterator
 
@@ -121,20 +124,51 @@ private:
             return tables->end();
         }
     };
-    class datatable_access : noncopyable {
+    class datatable_access : noncopyable { // lazy registry: datatable is created on first use
         friend class database;
-        shared_datatables tables;
-        void init(shared_datatables const & value) {
+        struct slot_type {
+            std::once_flag once;
+            shared_datatable table;
+        };
+        database const * const db;
+        shared_usertables tables; // sorted by name
+        std::unique_ptr<slot_type[]> slots;
+        void init(shared_usertables const & value) {
             tables = value;
             SDL_ASSERT(tables);
+            slots.reset(new slot_type[tables->size()]);
         }
     public:
-        using iterator = vector_shared_datatable::const_iterator;
+        using iterator = forward_iterator<datatable_access const, size_t>;
+        explicit datatable_access(database const * p): db(p) {
+            SDL_ASSERT(db);
+        }
         iterator begin() const {
-            return tables->begin();
+            size_t i = 0;
+            return iterator(this, std::move(i));
         }
         iterator end() const {
-            return tables->end();
+            size_t i = size();
+            return iterator(this, std::move(i));
+        }
+        size_t size() const {
+            return tables ? tables->size() : 0;
+        }
+        shared_datatable const & operator[](size_t) const; // thread safe
+        shared_datatable find(const std::string & name) const; // nullptr if not found
+        bool is_created(size_t i) const {
+            SDL_ASSERT(i < size());
+            return slots[i].table != nullptr;
+        }
+    private:
+        friend iterator;
+        size_t find_pos(const std::string & name) const; // size() if not found
+        void load_next(size_t & i) const {
+            SDL_ASSERT(i < size());
+            ++i;
+        }
+        shared_datatable const & dereference(size_t const i) const {
+            return (*this)[i];
         }
     };
     class iam_access {
@@ -158,12 +192,16 @@ private:
 private:
     class clustered_access: noncopyable {
         database const * const db;
+        schobj_id const table_id;
         page_head const * const min_page;
         page_head const * const max_page;
+        mutable std::once_flag m_runs_once;
+        mutable vector_page_run m_runs; // allocated pages from IAM, loaded by first scan
+        mutable std::atomic<size_t> m_runs_memory;
     public:
         using iterator = page_iterator<clustered_access const, page_head const *>;
-        clustered_access(database const * p, page_head const * _min, page_head const * _max)
-            : db(p), min_page(_min), max_page(_max) {
+        clustered_access(database const * p, schobj_id const id, page_head const * _min, page_head const * _max)
+            : db(p), table_id(id), min_page(_min), max_page(_max), m_runs_memory(0) {
             SDL_ASSERT(db && min_page && max_page);
             SDL_ASSERT(!min_page->data.prevPage);
             SDL_ASSERT(!max_page->data.nextPage);
@@ -174,13 +212,22 @@ private:
             page_head const * p = min_page;
             return iterator(this, std::move(p));
         }
+        page_head const * first_page() const {
+            return min_page;
+        }
+        page_head const * last_page() const {
+            return max_page;
+        }
+        void advise_scan() const; // leaf pages are expected to be mostly ordered inside page runs
+        size_t memory_size() const {
+            return m_runs_memory.load();
+        }
         iterator end() const {
             return iterator(this);
         }
         template<class page_pos>
         page_head const * load_next_head(page_pos const & p) const {
-            A_STATIC_CHECK_TYPE(page_head const *, p.first);
-            return db->load_next_head(p.first);
+            return db->load_next_head(p.first.get());
         }
     private:
         friend iterator;
@@ -212,13 +259,21 @@ private:
             page_head const * p = head;
             return iterator(this, std::move(p));
         }
+        page_head const * first_page() const {
+            return head;
+        }
+        void advise_scan() const {
+            db->advise_pages(head, head, map_advice::willneed);
+        }
+        static size_t memory_size() {
+            return 0;
+        }
         iterator end() const {
             return iterator(this);
         }
         template<class page_pos>
         page_head const * load_next_head(page_pos const & p) const {
-            A_STATIC_CHECK_TYPE(page_head const *, p.first);
-            return db->load_next_head(p.first);
+            return db->load_next_head(p.first.get());
         }
     private:
         friend iterator;
@@ -234,44 +289,77 @@ private:
         }
     };
     class heap_access: noncopyable {
-        vector_page_head const data;
+        database const * const db;
+        std::shared_ptr<vector_page_run const> const m_runs; // shared with page_prefetch, outlives evicted cache entry
+        vector_page_run const & data; // allocated pages from IAM, sorted by first page, not overlapped
+        pageType::type const page_type; // pages of other type are skipped while iterating
     public:
-        using iterator = vector_page_head::const_iterator;
-        heap_access(database const *, vector_page_head && v): data(std::move(v)) {}
+        using iterator = forward_iterator<heap_access const, page_head const *>;
+        heap_access(database const * p, vector_page_run && v, pageType::type const t)
+            : db(p), m_runs(std::make_shared<vector_page_run const>(std::move(v))), data(*m_runs), page_type(t) {
+            SDL_ASSERT(db);
+        }
         iterator begin() const {
-            return data.begin();
+            page_head const * p = find_page(0, 0);
+            return iterator(this, std::move(p));
         }
         iterator end() const {
-            return data.end();
+            return iterator(this);
+        }
+        vector_page_run const & runs() const {
+            return data;
+        }
+        pageType::type type() const {
+            return page_type;
         }
+        size_t memory_size() const {
+            return data.capacity() * sizeof(page_run);
+        }
+        void advise_scan() const;
         template<class page_pos>
         page_head const * load_next_head(page_pos const & p) const {
-            A_STATIC_CHECK_TYPE(size_t, p.second);
-            size_t const i = p.second + 1;
-            SDL_ASSERT(i <= data.size());
-            if (i < data.size()) {
-                return data[i];
-            }
-            return nullptr; 
+            return next_page(p.first.get());
+        }
+    private:
+        friend iterator;
+        static page_head const * dereference(page_head const * p) {
+            return p;
+        }
+        void load_next(page_head const * & p) const {
+            p = next_page(p);
         }
+        static bool is_end(page_head const * const p) {
+            return nullptr == p;
+        }
+        page_head const * find_page(size_t run, uint32 offset) const; // first page of page_type from position
+        page_head const * next_page(page_head const *) const;
     };
 private:
     template<class T> // T = clustered_access | heap_access
     class page_head_access_t final : public page_head_access {
+        database const * const db;
         T _access;
     public:
         template<typename... Ts>
-        page_head_access_t(Ts&&... params): _access(std::forward<Ts>(params)...) {}
+        page_head_access_t(database const * p, Ts&&... params): db(p), _access(p, std::forward<Ts>(params)...) {}
+        T const & access() const {
+            return _access;
+        }
+        size_t memory_size() const override {
+            return sizeof(*this) + _access.memory_size();
+        }
     private:
         page_pos begin_page() const override {
+            _access.advise_scan();
             auto it = _access.begin();
             if (it != _access.end()) {
-                return { *it, 0 };
+                return { db->lock_page(*it), 0 };
             }
             return {};
         }
         void load_next(page_pos & p) const override {
-            if ((p.first = _access.load_next_head(p)) != nullptr) {
+            if (page_head const * const next = _access.load_next_head(p)) {
+                p.first = db->lock_page(next); // previous page is unpinned after next one is pinned
                 ++(p.second);
             }
             else {
@@ -280,8 +368,17 @@ private:
         }
     };
 private:
+    void prefetch_heap(page_head const *, std::shared_ptr<vector_page_run const> const & runs, size_t run) const;
+    void load_extent(pageFileID const &, size_t count) const;
+    vector_page_run load_page_runs(schobj_id, dataType::type) const; // pages of allocation units from IAM
+    vector_page_run load_page_chunks(schobj_id, dataType::type) const; // page runs split for parallel reading
+    shared_key_filter make_key_filter(datatable const &) const;
+    shared_nonclustered_index make_nonclustered(shared_usertable const &, sysidxstats_row const *) const;
+    bool is_same_page(database const &, pageFileID const &) const;
+    bool is_same_sysalloc(database const &, schobj_id, dataType::type) const;
     page_head const * sysallocunits_head() const;
     page_head const * load_sys_obj(sysObj) const;
+    page_head const * load_resident_head(pageFileID const &) const; // page is kept by buffer pool, for cached pointers
 
     template<class T, class fun_type> static
     void for_row(page_access<T> const & obj, fun_type && fun) {
@@ -300,8 +397,6 @@ private:
         }
         return nullptr;
     }   
-    template<class fun_type> unique_datatable find_table_if(fun_type &&) const;
-    template<class fun_type> unique_datatable find_internal_if(fun_type &&) const;
 private:
     class pgroot_pgfirst {
         page_head const * m_pgroot = nullptr;  // root page of the index tree
@@ -320,11 +415,13 @@ private:
     pgroot_pgfirst load_pg_index(schobj_id, pageType::type) const; 
 public:
     explicit database(const std::string & fname);
+    database(const std::string & fname, database_param const &);
     ~database();
 
     const std::string & filename() const;
     bool is_open() const;
-    size_t page_count() const;
+    size_t page_count() const; // pages in primary data file
+    size_t file_count() const; // number of data files
 
     page_head const * load_page_head(pageIndex) const;
     page_head const * load_page_head(pageFileID const &) const;
@@ -341,6 +438,113 @@ public:
     using page_row = std::pair<page_head const *, row_head const *>;
     page_row load_page_row(recordID const &) const;
 
+    void advise_pages(pageIndex, size_t count, map_advice) const; // access hint for page range
+    void advise_pages(page_head const * first, page_head const * last, map_advice) const;
+    void advise_pages(pageFileID const & first, size_t count, map_advice) const;
+    void advise_pages(vector_page_run const &, map_advice) const; // every run, pages between runs are not advised
+
+    struct prefetch_stat {
+        size_t fetched = 0;
+        size_t hit = 0;
+        size_t wasted = 0;
+    };
+    prefetch_stat get_prefetch_stat() const; // empty if prefetch is disabled
+
+    struct pool_stat {
+        size_t hit = 0;
+        size_t miss = 0;
+        size_t evicted = 0;
+        size_t resident = 0;
+        size_t pinned = 0;
+        size_t frames = 0;
+        size_t batch_reads = 0;
+    };
+    pool_stat get_pool_stat() const; // empty if buffer pool is not used
+
+    struct open_stat { // per-phase time of database open, milliseconds
+        size_t populate_ms = 0;
+        size_t catalog_ms = 0;      // with preload of table caches on warm start
+        size_t index_ms = 0;
+        size_t populate_pages = 0;
+        size_t index_pages = 0;
+        size_t sidecar_ms = 0;      // rebuild and write stale sidecar
+        size_t pfs_ms = 0;          // decode PFS pages into allocation bitmap
+        bool sidecar_loaded = false; // catalog caches are loaded from sidecar
+    };
+    open_stat const & get_open_stat() const;
+
+    struct heatmap_entry { // page loads aggregated by allocation unit, index level and page type
+        auid_t auid{};          // allocation unit from page header
+        schobj_id id{};         // owner object; 0 if allocation unit is not found (system pages)
+        index_id indid{};
+        pageType::type type = pageType::type::null;
+        size_t level = 0;
+        size_t pages = 0;       // distinct pages loaded
+        size_t count = 0;       // page loads
+    };
+    using vector_heatmap = std::vector<heatmap_entry>;
+    // sorted by count descending; empty if heatmap is disabled (database_param::heatmap);
+    // counts start after database is opened, dump reads headers of counted pages
+    vector_heatmap get_heatmap() const;
+    void reset_heatmap() const;
+
+    struct memory_stat { // approximate heap bytes, see memory_usage()
+        size_t sysalloc = 0;        // allocation units of tables
+        size_t datapage = 0;        // heap page runs, first and last leaf pages
+        size_t pg_index = 0;        // index roots
+        size_t primary = 0;         // primary keys
+        size_t cluster = 0;         // cluster and nonclustered indexes
+        size_t spatial_tree = 0;
+        size_t index_cache = 0;     // lowest non-leaf level of clustered indexes
+        size_t key_filter = 0;      // Bloom filters over cluster keys
+        size_t catalog = 0;         // hash indexes over system tables
+        size_t pfs = 0;             // allocation bitmap
+        size_t pool = 0;            // buffer pool frames
+        size_t heap() const {       // sum of the above
+            return sysalloc + datapage + pg_index + primary + cluster + spatial_tree + index_cache + key_filter + catalog + pfs + pool;
+        }
+    };
+    struct table_memory {
+        schobj_id id{};
+        memory_stat stat;           // caches keyed by object id only
+    };
+    struct memory_report {
+        memory_stat total;
+        uint64 mapped = 0;          // resident bytes of mapped data files (RSS, not heap)
+        size_t evicted = 0;         // cache entries dropped above datapage_limit, sysalloc_limit
+        std::vector<table_memory> table; // sorted by heap bytes descending
+    };
+    memory_report memory_usage() const;
+
+    struct carry_stat { // see carry_cache
+        size_t carried = 0; // heap page lists taken over from previous version
+        size_t rebuilt = 0; // cache entries built again
+    };
+    // build cache entries used by previous version of database before it is replaced (see database_handle);
+    // heap page list is taken over by pageId if sysalloc rows, IAM and PFS pages of the object are identical
+    carry_stat carry_cache(database const & old);
+
+    using page_lock = std::shared_ptr<page_head const>; // page is valid while any copy is alive
+    page_lock lock_page(page_head const *) const; // pin page returned by load_page_head if buffer pool is used
+
+    class page_pin : noncopyable { // page is valid while page_pin is alive
+        database const * const db;
+        page_head const * const head;
+    public:
+        page_pin(database const *, pageFileID const &);
+        ~page_pin();
+        page_head const * get() const {
+            return head;
+        }
+        page_head const * operator->() const {
+            SDL_ASSERT(head);
+            return head;
+        }
+        explicit operator bool() const {
+            return head != nullptr;
+        }
+    };
+
     void const * start_address() const; // diagnostic
     void const * memory_offset(void const *) const; // diagnostic
 
@@ -367,13 +571,17 @@ public:
 
     usertable_access _usertables;
     internal_access _internals; // INTERNAL_TABLE
-    datatable_access _datatables;
+    datatable_access _datatables{this};
 
     //_usertables
     unique_datatable find_table(const std::string & name) const;
     unique_datatable find_table(schobj_id) const;
     shared_usertable find_table_schema(schobj_id) const;
 
+    // resolve datatables and their caches ahead of first use (empty = all user tables);
+    // returns number of tables found
+    size_t preload(std::vector<std::string> const & names) const;
+
     //_internals
     unique_datatable find_internal(const std::string & name) const;
     unique_datatable find_internal(schobj_id) const;
@@ -389,6 +597,9 @@ public:
     shared_cluster_index get_cluster_index(shared_usertable const &) const;
     shared_cluster_index get_cluster_index(schobj_id) const; 
     page_head const * get_cluster_root(schobj_id) const; 
+    shared_index_cache get_index_cache(shared_cluster_index const &) const; // nullptr if disabled by database_param
+    shared_key_filter get_key_filter(datatable const &) const; // nullptr if disabled by database_param or key_filter_limit
+    shared_vector_nonclustered get_nonclustered(shared_usertable const &) const; // supported nonclustered indexes, never nullptr
     
     shared_sysallocunits find_sysalloc(schobj_id, dataType::type) const;
     shared_page_head_access find_datapage(schobj_id, dataType::type, pageType::type) const;
@@ -401,6 +612,27 @@ public:
     }
     bool is_allocated(pageFileID const &) const;
     bool is_allocated(page_head const *) const;
+    pfs_byte get_pfs_byte(pageFileID const &) const; // page type and fullness from PFS
+
+    using page_range = std::pair<pageFileID, size_t>; // first page, page count
+    using vector_page_range = std::vector<page_range>;
+    vector_page_range allocated_ranges() const; // runs of allocated pages of all data files
+    size_t allocated_count() const;
+
+    struct table_size { // heap or clustered index, read from catalog only
+        uint64 rows = 0;            // sysrowsets.rcrows, maintained by server and may lag behind data pages
+        uint64 data_pages = 0;      // sysallocunits.pcdata
+        uint64 used_pages = 0;      // sysallocunits.pcused
+        uint64 reserved_pages = 0;  // sysallocunits.pcreserved
+    };
+    table_size get_table_size(schobj_id) const;
+
+    enum class row_count {
+        slots,      // slot array sizes of data pages; rows are not read, ghost and forwarded rows are counted
+        records     // same rows as datatable::record_access (ghost records and forwarding stubs are skipped)
+    };
+    // allocated data pages are found from IAM and counted by init_threads
+    size_t count_rows(schobj_id, row_count) const;
 
     auto get_access(identity<sysallocunits>)  const -> decltype((_sysallocunits))   { return _sysallocunits; }
     auto get_access(identity<sysschobjs>)     const -> decltype((_sysschobjs))      { return _sysschobjs; }
@@ -433,7 +665,6 @@ private:
 
     shared_usertables get_usertables() const;
     shared_usertables get_internals() const;
-    shared_datatables get_datatables() const;
 
     page_head const * load_page_head(sysPage) const;
     std::vector<page_head const *> load_page_list(page_head const *) const;
@@ -443,7 +674,12 @@ private:
     sysallocunits_row const * find_spatial_alloc(const std::string & index_name) const;
 private:
     void init_database();
-    void init_datatable(shared_usertable const &);
+    void init_catalog();
+    void init_pfs_bitmap();
+    void warm_index();
+    bool load_sidecar();
+    void save_sidecar();
+    void init_datatable(shared_usertable const &) const;
     using database_error = sdl_exception_t<database>;
     class shared_data;
     const std::unique_ptr<shared_data> m_data;
@@ -46,7 +46,7 @@ template<class T> inline
 void database::load_next(page_ptr<T> & p) const {
     if (p) {
         A_STATIC_CHECK_TYPE(page_head const * const, p->head);
-        if (auto h = this->load_next_head(p->head)) {
+        if (auto h = this->load_resident_head(p->head->data.nextPage)) { // rows of system tables are cached
             A_STATIC_CHECK_TYPE(page_head const *, h);
             reset_new(p, h);
         }
@@ -63,7 +63,7 @@ template<class T> inline
 void database::load_prev(page_ptr<T> & p) const {
     if (p) {
         A_STATIC_CHECK_TYPE(page_head const * const, p->head);
-        if (auto h = this->load_prev_head(p->head)) {
+        if (auto h = this->load_resident_head(p->head->data.prevPage)) {
             A_STATIC_CHECK_TYPE(page_head const *, h);
             reset_new(p, h);
         }
@@ -0,0 +1,98 @@
+// database_handle.cpp
+//
+#include "common/common.h"
+#include "database_handle.h"
+
+#if SDL_DEBUG
+namespace sdl {
+    namespace db {
+        namespace {
+            class test_database : noncopyable { // version of database with name of file
+                static std::atomic<size_t> & alive() {
+                    static std::atomic<size_t> count(0);
+                    return count;
+                }
+            public:
+                const std::string name;
+                test_database(const std::string & fname, database_param const &): name(fname) {
+                    ++alive();
+                }
+                ~test_database() {
+                    --alive();
+                }
+                bool is_open() const {
+                    return !name.empty();
+                }
+                database::carry_stat carry_cache(test_database const & old) {
+                    database::carry_stat result;
+                    result.carried = old.name.size();
+                    return result;
+                }
+                static size_t count() {
+                    return alive().load();
+                }
+            };
+            class unit_test {
+            public:
+                unit_test()
+                {
+                    SDL_TRACE_FILE;
+                    if (1) { // readers keep previous version while handle is swapped
+                        database_handle_t<test_database> handle("v1", database_param());
+                        auto snapshot = handle.get();
+                        SDL_ASSERT((handle.version() == 1) && (snapshot->name == "v1"));
+                        std::atomic<bool> stop(false);
+                        std::atomic<size_t> reads(0);
+                        std::thread reader([&handle, &stop, &reads](){
+                            do {
+                                auto const p = handle.get(); // either version, never destroyed while held
+                                SDL_ASSERT((p->name == "v1") || (p->name == "v2.mdf"));
+                                ++reads;
+                            } while (!stop);
+                        });
+                        SDL_ASSERT(handle.reload("v2.mdf"));
+                        SDL_ASSERT(handle.wait_reload());
+                        stop = true;
+                        reader.join();
+                        SDL_ASSERT(reads.load());
+                        SDL_ASSERT((handle.version() == 2) && (handle.get()->name == "v2.mdf"));
+                        SDL_ASSERT(handle.get_reload_stat().version == 2);
+                        SDL_ASSERT(handle.get_reload_stat().carried == 2); // cache carried from "v1"
+                        SDL_ASSERT(handle.get_reload_error().empty());
+                        SDL_ASSERT(snapshot->name == "v1");
+                        SDL_ASSERT(test_database::count() == 2);
+                        snapshot.reset(); // last reader of previous version
+                        SDL_ASSERT(test_database::count() == 1);
+                    }
+                    if (1) { // concurrent reload and wait_reload
+                        database_handle_t<test_database> handle("v1", database_param());
+                        std::atomic<size_t> started(0);
+                        std::vector<std::thread> threads;
+                        for (size_t t = 0; t < 4; ++t) {
+                            threads.emplace_back([&handle, &started, t](){
+                                for (size_t n = 0; n < 50; ++n) {
+                                    if (t & 1) {
+                                        SDL_ASSERT(handle.wait_reload());
+                                    }
+                                    else if (handle.reload("v" + std::to_string(n) + ".mdf")) {
+                                        ++started;
+                                    }
+                                }
+                            });
+                        }
+                        for (auto & t : threads) {
+                            t.join();
+                        }
+                        SDL_ASSERT(handle.wait_reload());
+                        SDL_ASSERT(!handle.is_reloading() && started.load());
+                        SDL_ASSERT(handle.version() == started.load() + 1);
+                        SDL_ASSERT(test_database::count() == 1);
+                    }
+                    SDL_ASSERT(!test_database::count());
+                }
+            };
+            static unit_test s_test;
+        }
+    } // db
+} // sdl
+#endif //#if SV_DEBUG
@@ -0,0 +1,67 @@
+// database_handle.h
+//
+#pragma once
+#ifndef __SDL_SYSTEM_DATABASE_HANDLE_H__
+#define __SDL_SYSTEM_DATABASE_HANDLE_H__
+
+#include "database.h"
+#include <thread>
+#include <mutex>
+#include <chrono>
+
+namespace sdl { namespace db {
+
+// Versioned database: updated file is opened and warmed in background thread,
+// then published with atomic swap of shared pointer (RCU style).
+// Query must hold the snapshot returned by get() until it is finished:
+// previous version is destroyed when the last snapshot of it is released.
+template<class T> // T = database
+class database_handle_t : noncopyable {
+    using database_handle_error = sdl_exception_t<database_handle_t>;
+public:
+    using shared_database = std::shared_ptr<T const>;
+    struct reload_stat {
+        size_t version = 0;
+        size_t open_ms = 0;     // open and warm new version
+        size_t carry_ms = 0;    // carry cache entries of previous version
+        size_t carried = 0;
+        size_t rebuilt = 0;
+    };
+    database_handle_t(const std::string & fname, database_param const &);
+    ~database_handle_t(); // waits for reload in progress
+
+    shared_database get() const;
+    size_t version() const; // 1 for database opened by constructor
+
+    // starts background reload, returns false if reload is in progress;
+    // new version is opened with warm_start
+    bool reload(const std::string & fname);
+    bool reload(const std::string & fname, database_param const &);
+
+    bool is_reloading() const;
+    bool wait_reload(); // returns false if last reload failed
+
+    reload_stat get_reload_stat() const; // last successful reload
+    std::string get_reload_error() const; // last failed reload
+private:
+    void run_reload(std::string fname, database_param);
+private:
+    shared_database m_db; // std::atomic_load/atomic_store only
+    std::atomic<size_t> m_version;
+    std::atomic<bool> m_reloading;
+    database_param m_param;
+    mutable std::mutex m_mutex;
+    reload_stat m_stat;
+    std::string m_error;
+    std::mutex m_thread_mutex; // guards m_thread, which is joined outside m_mutex taken by run_reload
+    std::thread m_thread;
+};
+
+using database_handle = database_handle_t<database>;
+
+} // db
+} // sdl
+
+#include "database_handle.inl"
+
+#endif // __SDL_SYSTEM_DATABASE_HANDLE_H__
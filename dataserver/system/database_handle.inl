@@ -0,0 +1,145 @@
+// database_handle.inl
+//
+#pragma once
+#ifndef __SDL_SYSTEM_DATABASE_HANDLE_INL__
+#define __SDL_SYSTEM_DATABASE_HANDLE_INL__
+
+namespace sdl { namespace db {
+
+namespace database_handle_ {
+
+inline size_t elapsed_ms(std::chrono::steady_clock::time_point const start) {
+    return static_cast<size_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count());
+}
+
+} // database_handle_
+
+template<class T>
+database_handle_t<T>::database_handle_t(const std::string & fname, database_param const & param)
+    : m_db(std::make_shared<T>(fname, param))
+    , m_version(1)
+    , m_reloading(false)
+    , m_param(param)
+{
+    m_stat.version = 1;
+}
+
+template<class T>
+database_handle_t<T>::~database_handle_t()
+{
+    std::lock_guard<std::mutex> lock(m_thread_mutex);
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+template<class T>
+typename database_handle_t<T>::shared_database
+database_handle_t<T>::get() const
+{
+    return std::atomic_load(&m_db);
+}
+
+template<class T>
+size_t database_handle_t<T>::version() const
+{
+    return m_version.load();
+}
+
+template<class T>
+bool database_handle_t<T>::is_reloading() const
+{
+    return m_reloading.load();
+}
+
+template<class T>
+bool database_handle_t<T>::reload(const std::string & fname)
+{
+    return reload(fname, m_param);
+}
+
+template<class T>
+bool database_handle_t<T>::reload(const std::string & fname, database_param const & param)
+{
+    std::lock_guard<std::mutex> lock(m_thread_mutex);
+    if (m_reloading.exchange(true)) {
+        return false;
+    }
+    if (m_thread.joinable()) { // previous reload is finished
+        m_thread.join();
+    }
+    m_thread = std::thread(&database_handle_t::run_reload, this, fname, param);
+    return true;
+}
+
+template<class T>
+bool database_handle_t<T>::wait_reload()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_thread_mutex); // other waiters block until reload is joined
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_error.empty();
+}
+
+template<class T>
+void database_handle_t<T>::run_reload(std::string const fname, database_param param)
+{
+    param.warm_start = true;
+    reload_stat stat;
+    std::string error;
+    try {
+        auto const start = std::chrono::steady_clock::now();
+        auto next = std::make_shared<T>(fname, param);
+        throw_error_if<database_handle_error>(!next->is_open(), "reload failed");
+        stat.open_ms = database_handle_::elapsed_ms(start);
+        {
+            auto const carry_start = std::chrono::steady_clock::now();
+            if (auto const old = get()) {
+                auto const carry = next->carry_cache(*old);
+                stat.carried = carry.carried;
+                stat.rebuilt = carry.rebuilt;
+            }
+            stat.carry_ms = database_handle_::elapsed_ms(carry_start);
+        }
+        std::atomic_store(&m_db, shared_database(std::move(next))); // in-flight queries keep previous version
+        stat.version = ++m_version;
+    }
+    catch (std::exception & e) { // exception must not leave reload thread
+        error = e.what();
+        SDL_WARNING(!"reload failed");
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (error.empty()) {
+            m_param = param;
+            m_stat = stat;
+        }
+        m_error = error;
+    }
+    m_reloading = false;
+}
+
+template<class T>
+typename database_handle_t<T>::reload_stat
+database_handle_t<T>::get_reload_stat() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stat;
+}
+
+template<class T>
+std::string database_handle_t<T>::get_reload_error() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_error;
+}
+
+} // db
+} // sdl
+
+#endif // __SDL_SYSTEM_DATABASE_HANDLE_INL__
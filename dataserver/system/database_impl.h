@@ -6,8 +6,11 @@
 
 #include "common/map_enum.h"
 #include "common/compact_map.h"
+#include "page_prefetch.h"
+#include "pfs_bitmap.h"
 #include <algorithm>
 #include <mutex>
+#include <unordered_map>
 
 namespace sdl { namespace db {
 
@@ -17,7 +20,7 @@ public:
     database_PageMapping& operator=(const database_PageMapping&) = delete;
     const PageMapping pm;
 protected:
-    explicit database_PageMapping(const std::string & fname): pm(fname){}
+    database_PageMapping(const std::string & fname, database_param const & param): pm(fname, param){}
     ~database_PageMapping(){}
 };
 
@@ -28,25 +31,138 @@ class database::shared_data final : public database_PageMapping {
     using map_primary = compact_map<schobj_id, shared_primary_key>;
     using map_cluster = compact_map<schobj_id, shared_cluster_index>;
     using map_spatial_tree = compact_map<schobj_id, spatial_tree_idx>;
+    using map_index_cache = compact_map<schobj_id, shared_index_cache>;
+    using map_key_filter = compact_map<schobj_id, shared_key_filter>;
+    using map_nonclustered = compact_map<schobj_id, shared_vector_nonclustered>;
     struct data_type {
         shared_usertables usertable;
         shared_usertables internal;
-        shared_datatables datatable;
+        data_type()
+            : usertable(std::make_shared<vector_shared_usertable>())
+            , internal(std::make_shared<vector_shared_usertable>())
+        {}
+    };
+    struct cache_type { // objects of one shard
         map_enum_1<map_sysalloc, dataType> sysalloc;
         map_enum_2<map_datapage, dataType, pageType> datapage; // not preloaded in init_database()
         map_enum_1<map_index, pageType> index;
         map_primary primary;
         map_cluster cluster;
         map_spatial_tree spatial_tree;
-        data_type()
-            : usertable(std::make_shared<vector_shared_usertable>())
-            , internal(std::make_shared<vector_shared_usertable>())
-            , datatable(std::make_shared<vector_shared_datatable>())
-        {}
+        map_index_cache index_cache;
+        map_key_filter key_filter;
+        map_nonclustered nonclustered;
+        size_t sysalloc_bytes = 0;  // memory_size of sysalloc values
+        size_t datapage_bytes = 0;  // memory_size of datapage values
     };
+    class shard_type : noncopyable { // caches are split by object id, so threads reading different tables do not share a mutex
+        std::mutex m_mutex;
+        cache_type m_cache;
+    public:
+        template<class fun_type>
+        auto apply(fun_type && fun) -> decltype(fun(std::declval<cache_type &>())) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return fun(m_cache);
+        }
+    };
+    enum { shard_bits = 5 };
+    enum { shard_count = 1 << shard_bits };
+    static size_t shard_index(schobj_id const id) { // multiplicative hash, object ids are often sequential
+        return static_cast<uint32>(static_cast<uint32>(id._32) * 2654435761u) >> (32 - shard_bits);
+    }
+    shard_type & shard(schobj_id const id) {
+        return m_shard[shard_index(id)];
+    }
+    template<class fun_type>
+    void for_shards(fun_type && fun) {
+        for (auto & s : m_shard) {
+            s.apply(fun);
+        }
+    }
+    // drops cache of other shards round robin while total is above limit;
+    // fun(cache_type &) clears cache of one shard and returns released bytes
+    template<class fun_type>
+    void evict(std::atomic<size_t> & total, size_t const limit, shard_type const & keep, fun_type && fun) {
+        for (size_t n = 0; (n < shard_count) && (total.load() > limit); ++n) {
+            shard_type & s = m_shard[(m_evict++) % shard_count];
+            if (&s != &keep) {
+                total -= s.apply(fun);
+            }
+        }
+    }
 public:
+    static size_t memory_size(shared_sysallocunits const & p) {
+        return p ? (sizeof(*p) + p->capacity() * sizeof(sysallocunits_row const *)) : 0;
+    }
+    static size_t memory_size(shared_page_head_access const & p) {
+        return p ? p->memory_size() : 0;
+    }
+    class catalog_type : noncopyable { // hash indexes over system tables, built once by init_database()
+        template<class map_type> static
+        typename map_type::mapped_type const &
+        find(map_type const & m, typename map_type::key_type const & key) {
+            static const typename map_type::mapped_type empty{};
+            auto const found = m.find(key);
+            return (found != m.end()) ? found->second : empty;
+        }
+    public:
+        using vector_syscolpars_row = std::vector<syscolpars_row const *>;
+        using vector_sysiscols_row = std::vector<sysiscols_row const *>;
+        std::unordered_map<schobj_id::type, vector_sysidxstats_row> idxstats;       // by object id
+        std::unordered_map<uint64, vector_sysallocunits_row> sysalloc;              // by ownerid
+        std::unordered_map<schobj_id::type, vector_syscolpars_row> colpars;         // by object id
+        std::unordered_map<schobj_id::type, vector_sysiscols_row> iscols;           // by idmajor
+        std::unordered_map<uint32, sysscalartypes_row const *> scalartypes;         // by id
+        std::unordered_map<uint64, sysrowsets_row const *> rowsets;                 // by rowsetid
+        std::unordered_map<std::string, shared_usertable> usertable_name;
+        std::unordered_map<schobj_id::type, shared_usertable> usertable_id;
+        std::unordered_map<std::string, shared_usertable> internal_name;
+        std::unordered_map<schobj_id::type, shared_usertable> internal_id;
+
+        size_t memory_size() const; // approximate heap bytes
+        vector_sysidxstats_row const & find_idxstats(schobj_id const id) const {
+            return find(idxstats, id._32);
+        }
+        vector_sysallocunits_row const & find_sysalloc(auid_t const ownerid) const {
+            return find(sysalloc, ownerid._64);
+        }
+        vector_syscolpars_row const & find_colpars(schobj_id const id) const {
+            return find(colpars, id._32);
+        }
+        vector_sysiscols_row const & find_iscols(schobj_id const id) const {
+            return find(iscols, id._32);
+        }
+        sysscalartypes_row const * find_scalartype(scalartype const id) const {
+            return find(scalartypes, id._32);
+        }
+        sysrowsets_row const * find_rowset(auid_t const rowsetid) const {
+            return find(rowsets, rowsetid._64);
+        }
+    };
+    catalog_type catalog; // read only after init_database()
     bool initialized = false;
-    explicit shared_data(const std::string & fname): database_PageMapping(fname){}
+    open_stat open;
+    size_t const init_threads;
+    bool const use_index_cache;
+    bool const use_key_filter;
+    bool const key_filter_sidecar;
+    size_t const key_filter_limit;
+    std::unique_ptr<pfs_bitmap> pfs; // built before init_database(), read only after
+    std::unique_ptr<page_prefetch> const prefetch; // destroyed before pm
+    shared_data(const std::string & fname, database_param const & param)
+        : database_PageMapping(fname, param)
+        , init_threads(param.init_threads ? param.init_threads : std::thread::hardware_concurrency())
+        , use_index_cache(param.index_cache)
+        , use_key_filter(param.key_filter)
+        , key_filter_sidecar(param.key_filter_sidecar)
+        , key_filter_limit(param.key_filter_limit)
+        , prefetch(param.prefetch_depth ? new page_prefetch(pm, param.prefetch_depth) : nullptr)
+        , m_sysalloc_limit(param.sysalloc_limit)
+        , m_datapage_limit(param.datapage_limit)
+    {}
+    size_t evicted() const {
+        return m_evicted.load();
+    }
 
     shared_usertables & usertable() { // get/set shared_ptr only
         return m_data.usertable;
@@ -54,9 +170,6 @@ public:
     shared_usertables & internal() {
         return m_data.internal;
     }
-    shared_datatables & datatable() {
-        return m_data.datatable;
-    }
     bool empty_usertable() {
         lock_guard lock(m_mutex);
         return m_data.usertable->empty();
@@ -65,91 +178,246 @@ public:
         lock_guard lock(m_mutex);
         return m_data.internal->empty();
     }
-    bool empty_datatable() {
-        lock_guard lock(m_mutex);
-        return m_data.datatable->empty();
-    }
     std::pair<shared_sysallocunits, bool> 
     find_sysalloc(schobj_id const id, dataType::type const data_type) {
-        lock_guard lock(m_mutex);
-        if (auto found = m_data.sysalloc.find(id, data_type)) {
-            return { *found, true };
-        }
-        return{};
+        return shard(id).apply([id, data_type](cache_type & c) -> std::pair<shared_sysallocunits, bool> {
+            if (auto found = c.sysalloc.find(id, data_type)) {
+                return { *found, true };
+            }
+            return{};
+        });
+    }
+    template<class fun_type> // fun(schobj_id, dataType::type, shared_sysallocunits)
+    void for_sysalloc(fun_type && fun) {
+        for_shards([&fun](cache_type & c) {
+            c.sysalloc.for_each(fun);
+        });
     }
     void set_sysalloc(schobj_id const id, dataType::type const data_type,
                       shared_sysallocunits const & value) {
-        lock_guard lock(m_mutex);
-        m_data.sysalloc(id, data_type) = value;
+        shard_type & s = shard(id);
+        s.apply([this, id, data_type, &value](cache_type & c) {
+            shared_sysallocunits & dest = c.sysalloc(id, data_type);
+            size_t const old_size = memory_size(dest);
+            size_t const new_size = memory_size(value);
+            dest = value;
+            c.sysalloc_bytes = c.sysalloc_bytes + new_size - old_size;
+            m_sysalloc_bytes += new_size;
+            m_sysalloc_bytes -= old_size;
+        });
+        if (m_sysalloc_limit && (m_sysalloc_bytes.load() > m_sysalloc_limit)) {
+            evict(m_sysalloc_bytes, m_sysalloc_limit, s, [this](cache_type & c) {
+                size_t const bytes = c.sysalloc_bytes;
+                m_evicted += c.sysalloc.size();
+                c.sysalloc.clear();
+                c.sysalloc_bytes = 0;
+                return bytes;
+            });
+        }
     }
     std::pair<shared_page_head_access, bool>
     find_datapage(schobj_id const id, dataType::type const data_type, pageType::type const page_type) {
-        lock_guard lock(m_mutex);
-        if (auto found = m_data.datapage.find(id, data_type, page_type)) {
-            return { *found, true };
-        }
-        return{};
+        return shard(id).apply([id, data_type, page_type](cache_type & c) -> std::pair<shared_page_head_access, bool> {
+            if (auto found = c.datapage.find(id, data_type, page_type)) {
+                return { *found, true };
+            }
+            return{};
+        });
+    }
+    template<class fun_type> // fun(schobj_id, dataType::type, pageType::type, shared_page_head_access)
+    void for_datapage(fun_type && fun) {
+        for_shards([&fun](cache_type & c) {
+            c.datapage.for_each(fun);
+        });
     }
     void set_datapage(schobj_id const id, 
                       dataType::type const data_type,
                       pageType::type const page_type,
                       shared_page_head_access const & value) {
-        lock_guard lock(m_mutex);
-        m_data.datapage(id, data_type, page_type) = value;
+        shard_type & s = shard(id);
+        s.apply([this, id, data_type, page_type, &value](cache_type & c) {
+            shared_page_head_access & dest = c.datapage(id, data_type, page_type);
+            size_t const old_size = memory_size(dest);
+            size_t const new_size = memory_size(value);
+            dest = value;
+            c.datapage_bytes = c.datapage_bytes + new_size - old_size;
+            m_datapage_bytes += new_size;
+            m_datapage_bytes -= old_size;
+        });
+        if (m_datapage_limit && (m_datapage_bytes.load() > m_datapage_limit)) {
+            evict(m_datapage_bytes, m_datapage_limit, s, [this](cache_type & c) {
+                size_t const bytes = c.datapage_bytes;
+                m_evicted += c.datapage.size();
+                c.datapage.clear();
+                c.datapage_bytes = 0;
+                return bytes;
+            });
+        }
     }
     std::pair<pgroot_pgfirst, bool> load_pg_index(schobj_id const id, pageType::type const page_type) {
-        lock_guard lock(m_mutex);
-        if (auto found = m_data.index.find(id, page_type)) {
-            return { *found, true };
-        }
-        return{};
+        return shard(id).apply([id, page_type](cache_type & c) -> std::pair<pgroot_pgfirst, bool> {
+            if (auto found = c.index.find(id, page_type)) {
+                return { *found, true };
+            }
+            return{};
+        });
+    }
+    template<class fun_type> // fun(schobj_id, pageType::type, pgroot_pgfirst)
+    void for_pg_index(fun_type && fun) {
+        for_shards([&fun](cache_type & c) {
+            c.index.for_each(fun);
+        });
     }
     void set_pg_index(schobj_id const id, pageType::type const page_type, pgroot_pgfirst const & value) {
-        lock_guard lock(m_mutex);
-        m_data.index(id, page_type) = value;
+        shard(id).apply([id, page_type, &value](cache_type & c) {
+            c.index(id, page_type) = value;
+        });
     }
     std::pair<shared_primary_key, bool> get_primary_key(schobj_id const table_id) {
-        lock_guard lock(m_mutex);
-        auto const found = m_data.primary.find(table_id);
-        if (found != m_data.primary.end()) {
-            return { found->second, true };
-        }
-        return{};
+        return shard(table_id).apply([table_id](cache_type & c) -> std::pair<shared_primary_key, bool> {
+            auto const found = c.primary.find(table_id);
+            if (found != c.primary.end()) {
+                return { found->second, true };
+            }
+            return{};
+        });
+    }
+    template<class fun_type> // fun(schobj_id, shared_primary_key)
+    void for_primary_key(fun_type && fun) {
+        for_shards([&fun](cache_type & c) {
+            for (auto const & p : c.primary) {
+                fun(p.first, p.second);
+            }
+        });
     }
     void set_primary_key(schobj_id const table_id, shared_primary_key const & value) {
-        lock_guard lock(m_mutex);
-        m_data.primary[table_id] = value;
+        shard(table_id).apply([table_id, &value](cache_type & c) {
+            c.primary[table_id] = value;
+        });
     }
     std::pair<shared_cluster_index, bool> get_cluster_index(schobj_id const id) {
-        lock_guard lock(m_mutex);
-        auto const found = m_data.cluster.find(id);
-        if (found != m_data.cluster.end()) {
-            return { found->second, true };
-        }
-        return{};
+        return shard(id).apply([id](cache_type & c) -> std::pair<shared_cluster_index, bool> {
+            auto const found = c.cluster.find(id);
+            if (found != c.cluster.end()) {
+                return { found->second, true };
+            }
+            return{};
+        });
+    }
+    template<class fun_type> // fun(schobj_id, shared_cluster_index)
+    void for_cluster_index(fun_type && fun) {
+        for_shards([&fun](cache_type & c) {
+            for (auto const & p : c.cluster) {
+                fun(p.first, p.second);
+            }
+        });
     }
     void set_cluster_index(schobj_id const id, shared_cluster_index const & value) {
-        lock_guard lock(m_mutex);
-        m_data.cluster[id] = value;
+        shard(id).apply([id, &value](cache_type & c) {
+            c.cluster[id] = value;
+        });
     }
     std::pair<spatial_tree_idx, bool> find_spatial_tree(schobj_id const table_id) {
-        lock_guard lock(m_mutex);
-        auto const found = m_data.spatial_tree.find(table_id);
-        if (found != m_data.spatial_tree.end()) {
-            return { found->second, true };
-        }
-        return{};
+        return shard(table_id).apply([table_id](cache_type & c) -> std::pair<spatial_tree_idx, bool> {
+            auto const found = c.spatial_tree.find(table_id);
+            if (found != c.spatial_tree.end()) {
+                return { found->second, true };
+            }
+            return{};
+        });
+    }
+    template<class fun_type> // fun(schobj_id, spatial_tree_idx)
+    void for_spatial_tree(fun_type && fun) {
+        for_shards([&fun](cache_type & c) {
+            for (auto const & p : c.spatial_tree) {
+                fun(p.first, p.second);
+            }
+        });
     }
     void set_spatial_tree(schobj_id const table_id, spatial_tree_idx const & value) {
-        lock_guard lock(m_mutex);
-        m_data.spatial_tree[table_id] = value;
+        shard(table_id).apply([table_id, &value](cache_type & c) {
+            c.spatial_tree[table_id] = value;
+        });
+    }
+    std::pair<shared_index_cache, bool> find_index_cache(schobj_id const table_id) {
+        return shard(table_id).apply([table_id](cache_type & c) -> std::pair<shared_index_cache, bool> {
+            auto const found = c.index_cache.find(table_id);
+            if (found != c.index_cache.end()) {
+                return { found->second, true };
+            }
+            return{};
+        });
+    }
+    template<class fun_type> // fun(schobj_id, shared_index_cache)
+    void for_index_cache(fun_type && fun) {
+        for_shards([&fun](cache_type & c) {
+            for (auto const & p : c.index_cache) {
+                fun(p.first, p.second);
+            }
+        });
+    }
+    void set_index_cache(schobj_id const table_id, shared_index_cache const & value) {
+        shard(table_id).apply([table_id, &value](cache_type & c) {
+            c.index_cache[table_id] = value;
+        });
+    }
+    std::pair<shared_key_filter, bool> find_key_filter(schobj_id const table_id) {
+        return shard(table_id).apply([table_id](cache_type & c) -> std::pair<shared_key_filter, bool> {
+            auto const found = c.key_filter.find(table_id);
+            if (found != c.key_filter.end()) {
+                return { found->second, true };
+            }
+            return{};
+        });
+    }
+    template<class fun_type> // fun(schobj_id, shared_key_filter)
+    void for_key_filter(fun_type && fun) {
+        for_shards([&fun](cache_type & c) {
+            for (auto const & p : c.key_filter) {
+                fun(p.first, p.second);
+            }
+        });
+    }
+    void set_key_filter(schobj_id const table_id, shared_key_filter const & value) {
+        shard(table_id).apply([table_id, &value](cache_type & c) {
+            c.key_filter[table_id] = value;
+        });
+    }
+    std::pair<shared_vector_nonclustered, bool> find_nonclustered(schobj_id const table_id) {
+        return shard(table_id).apply([table_id](cache_type & c) -> std::pair<shared_vector_nonclustered, bool> {
+            auto const found = c.nonclustered.find(table_id);
+            if (found != c.nonclustered.end()) {
+                return { found->second, true };
+            }
+            return{};
+        });
+    }
+    template<class fun_type> // fun(schobj_id, shared_vector_nonclustered)
+    void for_nonclustered(fun_type && fun) {
+        for_shards([&fun](cache_type & c) {
+            for (auto const & p : c.nonclustered) {
+                fun(p.first, p.second);
+            }
+        });
+    }
+    void set_nonclustered(schobj_id const table_id, shared_vector_nonclustered const & value) {
+        shard(table_id).apply([table_id, &value](cache_type & c) {
+            c.nonclustered[table_id] = value;
+        });
     }
 private:
     data_type const & const_data() const { return m_data; }
     data_type & data() { return m_data; }
     using lock_guard = std::lock_guard<std::mutex>;
-    std::mutex m_mutex;
+    std::mutex m_mutex; // usertable, internal
     data_type m_data;
+    shard_type m_shard[shard_count];
+    size_t const m_sysalloc_limit;
+    size_t const m_datapage_limit;
+    std::atomic<size_t> m_sysalloc_bytes{0};
+    std::atomic<size_t> m_datapage_bytes{0};
+    std::atomic<size_t> m_evict{0};     // next shard to evict
+    std::atomic<size_t> m_evicted{0};
 };
 
 } // db
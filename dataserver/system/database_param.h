@@ -0,0 +1,57 @@
+// database_param.h
+//
+#pragma once
+#ifndef __SDL_SYSTEM_DATABASE_PARAM_H__
+#define __SDL_SYSTEM_DATABASE_PARAM_H__
+
+namespace sdl { namespace db {
+
+struct database_param {
+    // windowed mapping: file is mapped on demand by windows of window_size bytes
+    // (power of two, multiple of page size); 0 = map whole file at once
+    size_t window_size = 0;
+    // max resident windows; windows not used recently are released above the limit (address range stays mapped); 0 = no limit
+    size_t window_limit = 0;
+    // disable readahead for whole file and ignore sequential/willneed scan hints (lookup-heavy workload)
+    bool random_only = false;
+    // pages touched ahead of scan position by background thread; 0 = no prefetch
+    size_t prefetch_depth = 0;
+    // buffer pool backend: file is read by pages into pool_size frames (per data file) instead of memory mapping;
+    // loaded pages stay in pool, only pages read by pin_page and unused read ahead are evicted; 0 = memory mapped file
+    size_t pool_size = 0;
+    bool is_pool() const {
+        return pool_size != 0;
+    }
+    // fault in mapping, catalog and upper index levels when database is opened
+    bool warm_start = false;
+    size_t warm_threads = 0; // 0 = number of hardware threads
+    // threads to resolve table schemas, keys, cluster indexes and spatial trees at open;
+    // 0 = number of hardware threads, 1 = serial
+    size_t init_threads = 0;
+    // secondary data files (.ndf) of the database; pages are routed by pageFileID::fileId
+    std::vector<std::string> data_files;
+    // count page loads per page (see database::get_heatmap)
+    bool heatmap = false;
+    // load catalog caches from sidecar file next to database file; sidecar is rebuilt if missing or stale
+    bool catalog_sidecar = false;
+    // approximate heap bytes of rebuildable caches (heap page runs and leaf pages, allocation units);
+    // entries are dropped above the limit and built again on demand; 0 = no limit
+    size_t datapage_limit = 0;
+    size_t sysalloc_limit = 0;
+    // copy lowest non-leaf level of clustered indexes into memory on first lookup (see index_cache)
+    bool index_cache = false;
+    // Bloom filter over cluster keys of a table, built from leaf pages on first lookup (see key_filter);
+    // key_filter_limit: max bytes of one filter, 0 = no limit; table gets no filter if limit is too small;
+    // key_filter_sidecar: filters are saved next to database file and loaded while database is not changed
+    bool key_filter = false;
+    size_t key_filter_limit = 0;
+    bool key_filter_sidecar = false;
+    bool is_windowed() const {
+        return window_size != 0;
+    }
+};
+
+} // db
+} // sdl
+
+#endif // __SDL_SYSTEM_DATABASE_PARAM_H__
@@ -163,20 +163,10 @@ public:
 
 template<class T> template<class fun_type>
 size_t datapage_t<T>::lower_bound(fun_type && less) const {
-    size_t count = this->size();
-    size_t first = 0;
-    SDL_ASSERT(count);
-    while (count) {
-        const size_t count2 = count / 2;
-        const size_t mid = first + count2;
-        if (less((*this)[mid])) {
-            first = mid + 1;
-            count -= count2 + 1;
-        }
-        else {
-            count = count2;
-        }
-    }
+    SDL_ASSERT(this->size());
+    size_t const first = algo::branchless_lower_bound(this->size(), [this, &less](size_t const i) {
+        return less((*this)[i]);
+    });
     SDL_ASSERT(first <= this->size());
     return first;
 }
@@ -4,6 +4,7 @@
 #include "datatable.h"
 #include "database.h"
 #include "page_info.h"
+#include <numeric>
 
 namespace sdl { namespace db {
 
@@ -13,13 +14,100 @@ datatable::datatable(database const * const p, shared_usertable const & t)
     , _record(this)
     , _head(this)
 {
-    m_primary_key = this->db->get_primary_key(this->get_id());
-    if (m_primary_key) {
-        m_cluster_index = this->db->get_cluster_index(this->schema);
-        if (m_cluster_index && m_cluster_index->is_root_index()) {
-            m_index_tree = std::make_shared<index_tree>(this->db, m_cluster_index);
+}
+
+datatable::meta_type const &
+datatable::meta() const
+{
+    std::call_once(m_meta_once, [this](){
+        m_meta.primary_key = this->db->get_primary_key(this->get_id());
+        if (m_meta.primary_key) {
+            m_meta.cluster_index = this->db->get_cluster_index(this->schema);
+            if (m_meta.cluster_index && m_meta.cluster_index->is_root_index()) {
+                m_meta.index_tree = std::make_shared<index_tree>(this->db, m_meta.cluster_index);
+                m_meta.index_tree->set_cache(this->db->get_index_cache(m_meta.cluster_index));
+            }
+        }
+        m_meta.nonclustered = this->db->get_nonclustered(this->schema);
+    });
+    return m_meta;
+}
+
+shared_key_filter const &
+datatable::get_key_filter() const
+{
+    std::call_once(m_filter_once, [this](){
+        if (is_index_tree()) {
+            m_key_filter = this->db->get_key_filter(*this);
+        }
+    });
+    return m_key_filter;
+}
+
+shared_vector_nonclustered const &
+datatable::get_nonclustered() const
+{
+    return meta().nonclustered;
+}
+
+nonclustered_index const *
+datatable::find_nonclustered(size_t const col) const
+{
+    nonclustered_index const * result = nullptr;
+    for (auto const & p : *get_nonclustered()) {
+        if (p->col_ind(0) == col) {
+            if (!result || (p->size() < result->size())) { // shorter key, more rows per page
+                result = p.get();
+            }
+        }
+    }
+    return result;
+}
+
+datatable::record_type
+datatable::find_locator(nonclustered_index const & index, char const * const leaf_key) const
+{
+    std::vector<char> buf;
+    return find_locator(index, leaf_key, buf);
+}
+
+datatable::record_type
+datatable::find_locator(nonclustered_index const & index, char const * const leaf_key, std::vector<char> & buf) const
+{
+    if (index.is_heap()) {
+        recordID id = index.get_RID(leaf_key);
+        for (size_t hop = 0; hop < 2; ++hop) { // forwarding record points to moved row
+            auto const p = this->db->load_page_row(id);
+            if (!p.second) {
+                break;
+            }
+            if (p.second->is_forwarding_record()) {
+                id = reinterpret_cast<forwarding_stub const *>(p.second)->data.row;
+                continue;
+            }
+            if (p.second->use_record()) {
+                return record_type(this, p.second
+#if SDL_DEBUG_RECORD_ID
+                    , id
+#endif
+                );
+            }
+            break;
         }
+        return {};
     }
+    index.get_cluster_key(leaf_key, buf);
+    return find_record(key_mem(buf.data(), buf.data() + buf.size()));
+}
+
+size_t datatable::count_records() const
+{
+    return db->count_rows(get_id(), database::row_count::records);
+}
+
+uint64 datatable::stat_record_count() const
+{
+    return db->get_table_size(get_id()).rows;
 }
 
 datatable::head_access::head_access(base_datatable const * p)
@@ -47,7 +135,7 @@ datatable::page_head_access::make_iterator(datatable const * const tab, pageFile
     SDL_ASSERT(tab && id);
     SDL_ASSERT_DEBUG_2(tab->db->find_datapage(tab->get_id(), dataType::type::IN_ROW_DATA, pageType::type::data).get() == this);
     if (page_head const * h = tab->db->load_page_head(id)) {
-        return iterator(this, page_pos(h, 0));
+        return iterator(this, page_pos(tab->db->lock_page(h), 0));
     }
     SDL_ASSERT(0);
     return this->end();
@@ -384,10 +472,10 @@ datatable::datapage_access::datapage_access(base_datatable const * p,
 datatable::column_order
 datatable::get_PrimaryKeyOrder() const
 {
-    if (m_primary_key) {
-        if (auto col = this->ut().find_col(m_primary_key->primary()).first) {
-            SDL_ASSERT(m_primary_key->first_order() != sortorder::NONE);
-            return { col, m_primary_key->first_order() };
+    if (shared_primary_key const & pk = get_PrimaryKey()) {
+        if (auto col = this->ut().find_col(pk->primary()).first) {
+            SDL_ASSERT(pk->first_order() != sortorder::NONE);
+            return { col, pk->first_order() };
         }
     }
     return { nullptr, sortorder::NONE };
@@ -396,8 +484,8 @@ datatable::get_PrimaryKeyOrder() const
 usertable::col_index
 datatable::get_PrimaryKeyCol() const
 {
-    if (m_primary_key) {
-        return this->ut().find_col(m_primary_key->primary());
+    if (shared_primary_key const & pk = get_PrimaryKey()) {
+        return this->ut().find_col(pk->primary());
     }
     return{};
 }
@@ -427,8 +515,8 @@ spatial_tree
 datatable::get_spatial_tree() const 
 {
     if (auto const tree = find_spatial_tree()) {
-        if (m_primary_key) {
-            return case_scalartype_to_key(m_primary_key->first_type(), make_spatial_tree(this, &tree));
+        if (shared_primary_key const & pk = get_PrimaryKey()) {
+            return case_scalartype_to_key(pk->first_type(), make_spatial_tree(this, &tree));
         }
         SDL_ASSERT(!"get_spatial_tree");
     }
@@ -438,7 +526,7 @@ datatable::get_spatial_tree() const
 datatable::record_iterator
 datatable::scan_table_with_record_key(key_mem const & key) const
 {
-    SDL_ASSERT(!m_index_tree); // scan small table without index tree
+    SDL_ASSERT(!is_index_tree()); // scan small table without index tree
     if (shared_cluster_index const & index = get_cluster_index()) {
         auto const last = _record.end();
         for (auto it = _record.begin(); it != last; ++it) {
@@ -457,28 +545,120 @@ datatable::scan_table_with_record_key(key_mem const & key) const
     return _record.end();
 }
 
+namespace {
+
+size_t const none_offset = size_t(-1);
+
+// offset of cluster key in fixed data of row if key columns are stored one after another in key order
+size_t cluster_key_offset(usertable const & ut, cluster_index const & index)
+{
+    size_t offset = none_offset;
+    size_t length = 0;
+    for (size_t i = 0; i < index.size(); ++i) {
+        size_t const col = index.col_ind(i);
+        if (!ut.is_fixed(col)) {
+            return none_offset;
+        }
+        if (!i) {
+            offset = ut.fixed_offset(col);
+        }
+        else if (ut.fixed_offset(col) != offset + length) {
+            return none_offset;
+        }
+        length += index.sub_key_length(i);
+    }
+    return offset;
+}
+
+} // namespace
+
+class datatable::key_search : noncopyable {
+    datatable const * const table;
+    index_tree const * const tree;
+    key_compare const & compare;
+    bool const is_integer;  // key column is compared as integer
+    size_t const offset;    // of cluster key in fixed data, rows are not decoded
+    size_t const length;
+public:
+    key_search(datatable const * const t, index_tree const * const tr)
+        : table(t), tree(tr)
+        , compare(tr->get_compare())
+        , is_integer(tr->index().is_integer_key())
+        , offset(cluster_key_offset(t->ut(), tr->index()))
+        , length(tr->index().key_length())
+    {
+        SDL_ASSERT(!is_integer || (offset != none_offset));
+    }
+    char const * row_key(row_head const * const row) const {
+        SDL_ASSERT(offset != none_offset);
+        SDL_ASSERT(row->fixed_data().first + offset + length <= row->fixed_data().second);
+        return row->fixed_data().first + offset;
+    }
+    int64 integer_key(key_mem const & key) const {
+        SDL_ASSERT(mem_size(key) == length);
+        return index_cache::integer_key(key.first, length);
+    }
+    int64 integer_key(row_head const * const row) const {
+        return index_cache::integer_key(row_key(row), length);
+    }
+    bool row_less(row_head const * const row, key_mem const & key) const { // row key < key
+        if (is_integer) {
+            return integer_key(row) < integer_key(key);
+        }
+        if (offset != none_offset) {
+            return compare.less(row_key(row), key.first);
+        }
+        return tree->key_less(record_type(table, row).get_cluster_key(tree->index()), key);
+    }
+    bool key_less(key_mem const & key, row_head const * const row) const { // key < row key
+        if (offset != none_offset) {
+            return compare.less(key.first, row_key(row));
+        }
+        return tree->key_less(key, record_type(table, row).get_cluster_key(tree->index()));
+    }
+    size_t find_slot(datapage const & data, key_mem const & key) const { // data.size() if not found
+        SDL_ASSERT(!data.empty());
+        size_t slot;
+        bool found;
+        if (is_integer) {
+            int64 const k = integer_key(key);
+            slot = data.lower_bound([this, k](row_head const * const row) {
+                return integer_key(row) < k;
+            });
+            found = (slot < data.size()) && !(k < integer_key(data[slot]));
+        }
+        else {
+            slot = data.lower_bound([this, &key](row_head const * const row) {
+                return row_less(row, key);
+            });
+            found = (slot < data.size()) && !key_less(key, data[slot]);
+        }
+        return found ? slot : data.size();
+    }
+};
+
 template<class ret_type, class fun_type>
 ret_type datatable::find_row_head_impl(key_mem const & key, fun_type const & fun) const
 {
     SDL_ASSERT(mem_size(key));
     SDL_ASSERT(is_index_tree());
-    if (m_index_tree) {
-        if (auto const id = m_index_tree->find_page(key)) {
+    if (shared_index_tree const & tree = get_index_tree()) {
+        key_filter const * const filter = (mem_size(key) == tree->index().key_length()) ?
+            get_key_filter().get() : nullptr; // prefix of key is not filtered
+        if (filter && !filter->lookup(key)) {
+            return ret_type(); // key is not in table
+        }
+        if (auto const id = tree->find_page(key)) {
             if (page_head const * const h = db->load_page_head(id)) {
                 SDL_ASSERT(h->is_data());
                 const datapage data(h);
                 if (!data.empty()) {
-                    index_tree const * const tr = m_index_tree.get();
-                    size_t const slot = data.lower_bound(
-                        [this, tr, key](row_head const * const row) {
-                        return tr->key_less(
-                            record_type(this, row).get_cluster_key(tr->index()),
-                            key);
-                    });
+                    size_t const slot = key_search(this, tree.get()).find_slot(data, key);
                     if (slot < data.size()) {
-                        if (!tr->key_less(key, record_type(this, data[slot]).get_cluster_key(tr->index()))) {
-                            return fun(data[slot], recordID::init(id, slot)); //FIXME: skip recordID::init ?
-                        }
+                        return fun(data[slot], recordID::init(id, slot)); //FIXME: skip recordID::init ?
+                    }
+                    if (filter) {
+                        filter->false_positive();
                     }
                     return ret_type();
                 }
@@ -492,7 +672,7 @@ ret_type datatable::find_row_head_impl(key_mem const & key, fun_type const & fun
 datatable::record_iterator
 datatable::find_record_iterator(key_mem const & key) const
 {
-    if (m_index_tree) {
+    if (is_index_tree()) {
         if (auto const found = find_row_head_impl<recordID>(key,
             [](row_head const *, recordID const & id) {
                 return id; }))
@@ -508,7 +688,7 @@ datatable::find_record_iterator(key_mem const & key) const
 row_head const *
 datatable::find_row_head(key_mem const & key) const
 {
-    if (m_index_tree) {
+    if (is_index_tree()) {
         return find_row_head_impl<row_head const *>(key, [](row_head const * head, recordID const &) {
             return head;
         });
@@ -525,7 +705,7 @@ datatable::find_row_head(key_mem const & key) const
 datatable::record_type
 datatable::find_record(key_mem const & key) const
 {
-    if (m_index_tree) {
+    if (is_index_tree()) {
         return find_row_head_impl<record_type>(key, [this](row_head const * head, recordID const & id) {
             return record_type(this, head
     #if SDL_DEBUG_RECORD_ID
@@ -543,6 +723,288 @@ datatable::find_record(key_mem const & key) const
     }
 }
 
+std::vector<datatable::record_type>
+datatable::find_many(std::vector<key_mem> const & keys) const
+{
+    std::vector<record_type> result;
+    result.reserve(keys.size());
+    if (!is_index_tree()) {
+        for (auto const & key : keys) {
+            result.push_back(find_record(key));
+        }
+        return result;
+    }
+    index_tree const * const tree = get_index_tree().get();
+    size_t const key_length = tree->index().key_length();
+    using found_type = std::pair<row_head const *, recordID>;
+    std::vector<found_type> found(keys.size(), found_type(nullptr, recordID{}));
+    std::vector<size_t> order;
+    order.reserve(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        if (mem_size(keys[i]) == key_length) {
+            order.push_back(i);
+        }
+        else { // prefix key is not ordered by key_less, it is searched alone
+            SDL_ASSERT(mem_size(keys[i]) < key_length);
+            found[i] = find_row_head_impl<found_type>(keys[i], [](row_head const * head, recordID const & id) {
+                return found_type(head, id);
+            });
+        }
+    }
+    std::sort(order.begin(), order.end(), [tree, &keys](size_t const x, size_t const y) {
+        return tree->key_less(keys[x], keys[y]);
+    });
+    key_search const search(this, tree);
+    key_filter const * const filter = get_key_filter().get();
+    page_head const * page = nullptr;
+    for (size_t const i : order) {
+        key_mem const & key = keys[i];
+        SDL_ASSERT(mem_size(key) == key_length);
+        bool const filtered = (filter != nullptr);
+        if (filtered && !filter->lookup(key)) {
+            continue; // key is not in table
+        }
+        if (page && search.row_less(datapage(page).back(), key)) {
+            page = nullptr; // key is after last row of page, so it belongs to one of next pages
+        }
+        if (!page) {
+            if (auto const id = tree->find_page(key)) {
+                page = db->load_page_head(id);
+                SDL_ASSERT(page && page->is_data());
+                if (page && datapage(page).empty()) {
+                    page = nullptr;
+                }
+            }
+        }
+        if (page) {
+            const datapage data(page);
+            size_t const slot = search.find_slot(data, key);
+            if (slot < data.size()) {
+                found[i] = found_type(data[slot], recordID::init(page->data.pageId, slot));
+            }
+            else if (filtered) {
+                filter->false_positive();
+            }
+        }
+    }
+    for (auto const & f : found) {
+        if (f.first) {
+            result.push_back(record_type(this, f.first
+    #if SDL_DEBUG_RECORD_ID
+                , f.second
+    #endif
+                ));
+        }
+        else {
+            result.push_back(record_type());
+        }
+    }
+    return result;
+}
+
+datatable::range_cursor
+datatable::find_range(key_bound const & lo, key_bound const & hi, scan_order const order) const
+{
+    return range_cursor(this, lo, hi, order);
+}
+
+datatable::range_cursor::range_cursor(datatable const * const table,
+    key_bound const & lo, key_bound const & hi, scan_order const order)
+    : m_table(table)
+    , m_index(table->get_cluster_index().get())
+    , m_tree(table->get_index_tree().get())
+    , m_lo(lo.key.first, lo.key.second)
+    , m_hi(hi.key.first, hi.key.second)
+    , m_lo_inclusive(lo.inclusive)
+    , m_hi_inclusive(hi.inclusive)
+    , m_order(order)
+{
+    if (!m_index) {
+        SDL_ASSERT(!"range_cursor"); // key range requires clustered index
+        return;
+    }
+    reset_new(m_compare, *m_index);
+    m_offset = cluster_key_offset(table->ut(), *m_index);
+    m_lo_columns = m_compare->prefix_columns(m_lo.size());
+    m_hi_columns = m_compare->prefix_columns(m_hi.size());
+    SDL_ASSERT(m_lo.empty() || m_lo_columns);
+    SDL_ASSERT(m_hi.empty() || m_hi_columns);
+    if (m_order == scan_order::forward) {
+        seek_lo();
+    }
+    else {
+        seek_hi();
+    }
+}
+
+int datatable::range_cursor::compare(row_head const * const row, std::vector<char> const & bound, size_t const columns) const
+{
+    SDL_ASSERT(!bound.empty() && columns);
+    if (m_offset != none_offset) {
+        SDL_ASSERT(row->fixed_data().first + m_offset + m_compare->key_length() <= row->fixed_data().second);
+        return m_compare->compare(row->fixed_data().first + m_offset, bound.data(), columns);
+    }
+    return m_compare->compare(record_type(m_table, row).get_cluster_key(*m_index), bound.data(), columns);
+}
+
+bool datatable::range_cursor::before_lo(row_head const * const row) const
+{
+    if (m_lo.empty()) {
+        return false;
+    }
+    int const c = compare(row, m_lo, m_lo_columns);
+    return m_lo_inclusive ? (c < 0) : (c <= 0);
+}
+
+bool datatable::range_cursor::after_hi(row_head const * const row) const
+{
+    if (m_hi.empty()) {
+        return false;
+    }
+    int const c = compare(row, m_hi, m_hi_columns);
+    return m_hi_inclusive ? (c > 0) : (c >= 0);
+}
+
+page_head const *
+datatable::range_cursor::load_page(pageFileID const & id) const
+{
+    if (m_tree) {
+        if (page_head const * const page = m_table->db->load_page_head(id)) {
+            SDL_ASSERT(page->is_data());
+            return page;
+        }
+        SDL_ASSERT(0);
+        return nullptr;
+    }
+    SDL_ASSERT(m_index->is_root_data());
+    return m_index->root();
+}
+
+void datatable::range_cursor::set_page(page_head const * const p)
+{
+    m_lock = m_table->db->lock_page(p); // previous page is unpinned after p is pinned
+    m_page = m_lock.get();
+}
+
+void datatable::range_cursor::seek_lo()
+{
+    if (m_lo.empty()) {
+        set_page(load_page(m_tree ? m_tree->min_page() : pageFileID{}));
+        m_slot = 0;
+    }
+    else {
+        set_page(load_page(m_tree ? m_tree->lower_page(
+            key_mem(m_lo.data(), m_lo.data() + m_lo.size()), !m_lo_inclusive) : pageFileID{}));
+        m_slot = 0;
+        if (m_page) {
+            const datapage data(m_page);
+            if (!data.empty()) {
+                m_slot = data.lower_bound([this](row_head const * const row) {
+                    return before_lo(row);
+                });
+            }
+        }
+    }
+    skip_forward();
+}
+
+void datatable::range_cursor::seek_hi()
+{
+    if (m_hi.empty()) {
+        set_page(load_page(m_tree ? m_tree->max_page() : pageFileID{}));
+        m_slot = m_page ? slot_array::size(m_page) : 0;
+    }
+    else {
+        set_page(load_page(m_tree ? m_tree->lower_page(
+            key_mem(m_hi.data(), m_hi.data() + m_hi.size()), m_hi_inclusive) : pageFileID{}));
+        m_slot = 0;
+        if (m_page) {
+            const datapage data(m_page);
+            if (!data.empty()) {
+                m_slot = data.lower_bound([this](row_head const * const row) {
+                    return !after_hi(row);
+                });
+            }
+        }
+    }
+    prev_row(); // last row which is not after hi
+}
+
+void datatable::range_cursor::skip_forward()
+{
+    while (m_page) {
+        if (m_slot >= slot_array::size(m_page)) {
+            set_page(m_table->db->load_next_head(m_page));
+            m_slot = 0;
+            continue;
+        }
+        row_head const * const row = head();
+        if (!row->use_record()) { // same rows as skipped by head_access
+            ++m_slot;
+            continue;
+        }
+        if (after_hi(row)) {
+            set_page(nullptr);
+        }
+        break;
+    }
+}
+
+void datatable::range_cursor::next_row()
+{
+    SDL_ASSERT(m_page);
+    ++m_slot;
+    skip_forward();
+}
+
+void datatable::range_cursor::prev_row()
+{
+    while (m_page) {
+        if (!m_slot) {
+            set_page(m_table->db->load_prev_head(m_page));
+            m_slot = m_page ? slot_array::size(m_page) : 0;
+            continue;
+        }
+        --m_slot;
+        row_head const * const row = head();
+        if (!row->use_record()) {
+            continue;
+        }
+        if (before_lo(row)) {
+            set_page(nullptr);
+        }
+        break;
+    }
+}
+
+void datatable::range_cursor::next()
+{
+    SDL_ASSERT(m_page);
+    if (m_order == scan_order::forward) {
+        next_row();
+    }
+    else {
+        prev_row();
+    }
+}
+
+row_head const *
+datatable::range_cursor::head() const
+{
+    SDL_ASSERT(m_page && (m_slot < slot_array::size(m_page)));
+    return datapage(m_page)[m_slot];
+}
+
+datatable::record_type
+datatable::range_cursor::record() const
+{
+    return record_type(m_table, head()
+#if SDL_DEBUG_RECORD_ID
+        , recordID::init(m_page->data.pageId, m_slot)
+#endif
+    );
+}
+
 } // db
 } // sdl
 
@@ -6,8 +6,11 @@
 
 #include "sysobj/iam_page.h"
 #include "index_tree.h"
+#include "key_filter.h"
+#include "nonclustered_index.h"
 #include "spatial/spatial_tree.h"
 #include "spatial/geography.h"
+#include <mutex>
 
 #if (SDL_DEBUG > 1) && defined(SDL_OS_WIN32)
 #define SDL_DEBUG_RECORD_ID     1
@@ -62,7 +65,7 @@ public:
 //------------------------------------------------------------------
     class page_head_access: noncopyable {
     protected:
-        using page_pos = std::pair<page_head const *, size_t>;
+        using page_pos = std::pair<std::shared_ptr<page_head const>, size_t>; // page is pinned while iterator points to it
         virtual page_pos begin_page() const = 0;
     public:
         using iterator = forward_iterator<page_head_access const, page_pos>;
@@ -74,10 +77,11 @@ public:
             return iterator(this);
         }
         iterator make_iterator(datatable const *, pageFileID const &) const;
+        virtual size_t memory_size() const = 0; // approximate heap bytes
     private:
         friend iterator;
         static page_head const * dereference(page_pos const & p) {
-            return p.first;
+            return p.first.get();
         }
         virtual void load_next(page_pos &) const = 0;
         static bool is_end(page_pos const & p) {
@@ -267,13 +271,18 @@ public:
 
     shared_cluster_index const & get_cluster_index() const;  
     shared_index_tree const & get_index_tree() const;
+    shared_key_filter const & get_key_filter() const; // built on first call, nullptr if disabled
+    shared_vector_nonclustered const & get_nonclustered() const; // supported nonclustered indexes
+    size_t count_records() const; // same as _record.count(), data pages from IAM are counted in parallel
+    uint64 stat_record_count() const; // sysrowsets.rcrows from catalog, may lag behind data pages
+    nonclustered_index const * find_nonclustered(size_t col) const; // first key column is col, nullptr if not found
     spatial_tree get_spatial_tree() const;
 
     template<typename pk0_type> unique_spatial_tree_t<pk0_type>
     get_spatial_tree(identity<pk0_type>) const;
 
     bool is_index_tree() const {
-        return !!m_index_tree;
+        return !!get_index_tree();
     }
     row_head const * find_row_head(key_mem const &) const;
 
@@ -306,17 +315,111 @@ public:
     record_iterator find_t(T const & key) const {
         return find_record_iterator_t(key);
     }
+    // records in order of keys, null record if key is not found;
+    // keys are searched in sorted order, so keys on the same leaf page share one page visit;
+    // prefix key (first columns of cluster key) is not batched and costs one find_row_head
+    std::vector<record_type> find_many(std::vector<key_mem> const &) const;
+
+    template<class T>
+    std::vector<record_type> find_many_t(std::vector<T> const & keys) const {
+        std::vector<key_mem> v(keys.size());
+        for (size_t i = 0; i < keys.size(); ++i) {
+            const char * const p = reinterpret_cast<const char *>(&keys[i]);
+            v[i] = key_mem(p, p + sizeof(T));
+        }
+        return find_many(v);
+    }
+    struct key_bound { // cluster key or its first columns
+        key_mem key; // empty: range is not bounded
+        bool inclusive;
+        key_bound() : inclusive(false) {}
+        key_bound(key_mem const & k, bool i) : key(k), inclusive(i) {}
+    };
+    enum class scan_order { forward, reverse };
+    class range_cursor;
+    // rows between lo and hi in index order or reverse; cursor starts with index seek
+    // and stops at first key out of range, so pages outside of range are not read
+    range_cursor find_range(key_bound const & lo, key_bound const & hi, scan_order = scan_order::forward) const;
+
+    template<class fun_type> // fun(record_type) returns bool or break_or_continue
+    break_or_continue scan_range(key_bound const & lo, key_bound const & hi, scan_order, fun_type &&) const;
+
+    // record of nonclustered index leaf row, looked up by cluster key or heap RID; null record if not found
+    record_type find_locator(nonclustered_index const &, char const * leaf_key) const;
+
+    // rows of index range in index order; bounds are first columns of nonclustered index key,
+    // rows with NULL in bounded key columns are skipped
+    template<class fun_type> // fun(record_type) returns bool or break_or_continue
+    break_or_continue scan_index(nonclustered_index const &, key_bound const & lo, key_bound const & hi, fun_type &&) const;
     template<class T, class fun_type> static
     void for_datarow(T && data, fun_type && fun);
 private:
+    class key_search; // cluster key compared with rows of data page
     template<class ret_type, class fun_type>
     ret_type find_row_head_impl(key_mem const &, fun_type const &) const;
     spatial_tree_idx find_spatial_tree() const;
     record_iterator scan_table_with_record_key(key_mem const &) const;
+    record_type find_locator(nonclustered_index const &, char const * leaf_key, std::vector<char> & buf) const;
+private:
+    struct meta_type {
+        shared_primary_key primary_key;
+        shared_cluster_index cluster_index;
+        shared_index_tree index_tree;
+        shared_vector_nonclustered nonclustered;
+    };
+    meta_type const & meta() const; // resolved once on first use
+private:
+    mutable std::once_flag m_meta_once;
+    mutable meta_type m_meta;
+    mutable std::once_flag m_filter_once;
+    mutable shared_key_filter m_key_filter;
+};
+
+class datatable::range_cursor {
+public:
+    range_cursor(datatable const *, key_bound const & lo, key_bound const & hi, scan_order);
+    explicit operator bool() const {
+        return !!m_page;
+    }
+    row_head const * head() const;
+    record_type record() const;
+    page_head const * page() const {
+        return m_page;
+    }
+    size_t slot() const {
+        return m_slot;
+    }
+    std::shared_ptr<page_head const> const & lock() const { // keeps page() after cursor is destroyed
+        return m_lock;
+    }
+    void next();
+private:
+    int compare(row_head const *, std::vector<char> const &, size_t) const;
+    bool before_lo(row_head const *) const;
+    bool after_hi(row_head const *) const;
+    page_head const * load_page(pageFileID const &) const;
+    void set_page(page_head const *); // pins current page
+    void seek_lo();
+    void seek_hi();
+    void next_row();
+    void prev_row();
+    void skip_forward(); // to first used row at or after m_slot
 private:
-    shared_primary_key m_primary_key;
-    shared_cluster_index m_cluster_index;
-    shared_index_tree m_index_tree;
+    datatable const * const m_table;
+    cluster_index const * const m_index;
+    index_tree const * const m_tree; // nullptr if root of clustered index is data page
+    std::vector<char> const m_lo; // bounds are copied
+    std::vector<char> const m_hi;
+    bool const m_lo_inclusive;
+    bool const m_hi_inclusive;
+    scan_order const m_order;
+    std::unique_ptr<key_compare const> m_compare;
+    size_t m_offset = 0; // of cluster key in fixed data if key columns are stored in key order
+    size_t m_lo_columns = 0;
+    size_t m_hi_columns = 0;
+    page_head const * m_page = nullptr; // nullptr at end of range
+    std::shared_ptr<page_head const> m_lock; // m_page is not evicted from buffer pool
+    size_t m_slot = 0;
 };
 
 using shared_datatable = std::shared_ptr<datatable>; 
@@ -23,17 +23,17 @@ datatable::get_datarow(dataType::type t1, pageType::type t2) {
 
 inline shared_primary_key const &
 datatable::get_PrimaryKey() const {
-    return m_primary_key;
+    return meta().primary_key;
 }
 
 inline shared_cluster_index const &
 datatable::get_cluster_index() const {
-    return m_cluster_index;
+    return meta().cluster_index;
 }
 
 inline shared_index_tree const &
 datatable::get_index_tree() const {
-    return m_index_tree;
+    return meta().index_tree;
 }
 
 //----------------------------------------------------------------------
@@ -230,6 +230,42 @@ datatable::find_record_iterator(vector_mem_range_t const & v) const {
     return find_record_iterator(make_mem_range(buf));
 }
 
+template<class fun_type> break_or_continue
+datatable::scan_range(key_bound const & lo, key_bound const & hi, scan_order const order, fun_type && fun) const {
+    for (range_cursor it = find_range(lo, hi, order); it; it.next()) {
+        if (is_break(fun(it.record()))) {
+            return bc::break_;
+        }
+    }
+    return bc::continue_;
+}
+
+template<class fun_type>
+break_or_continue
+datatable::scan_index(nonclustered_index const & index, key_bound const & lo, key_bound const & hi, fun_type && fun) const {
+    SDL_ASSERT(index.get_id() == get_id());
+    key_compare const & compare = index.get_compare();
+    size_t const columns = a_max(
+        mem_size(lo.key) ? compare.prefix_columns(mem_size(lo.key)) : 0,
+        mem_size(hi.key) ? compare.prefix_columns(mem_size(hi.key)) : 0);
+    std::vector<char> buf; // cluster key
+    const nonclustered_tree tree(this->db, index);
+    return tree.scan_range(lo.key, lo.inclusive, hi.key, hi.inclusive,
+        [this, &index, columns, &buf, &fun](char const * const leaf_key) {
+        record_type const record = find_locator(index, leaf_key, buf);
+        if (!record) {
+            SDL_ASSERT(0);
+            return bc::continue_;
+        }
+        for (size_t i = 0; i < columns; ++i) {
+            if (record.is_null(index.col_ind(i))) { // NULL is stored as value in index key
+                return bc::continue_;
+            }
+        }
+        return make_break_or_continue(fun(record));
+    });
+}
+
 //----------------------------------------------------------------------
 
 } // db
@@ -0,0 +1,117 @@
+// index_cache.cpp
+//
+#include "common/common.h"
+#include "index_cache.h"
+
+namespace sdl { namespace db {
+
+index_cache::index_cache(size_t const key_length, size_t const reserve)
+    : m_key_length(key_length)
+{
+    SDL_ASSERT(m_key_length);
+    m_page.reserve(reserve);
+    m_sorted.reserve(reserve * m_key_length);
+}
+
+void index_cache::push_back(char const * const key, pageFileID const & id)
+{
+    SDL_ASSERT(m_key.empty());
+    if (!m_page.empty()) {
+        SDL_ASSERT(key);
+        m_sorted.insert(m_sorted.end(), key, key + m_key_length);
+    }
+    m_page.push_back(id);
+}
+
+size_t index_cache::fill(size_t pos, size_t const slot) // in-order walk of implicit tree
+{
+    if (slot < m_page.size()) {
+        pos = fill(pos, 2 * slot);
+        SDL_ASSERT(pos < m_page.size() - 1);
+        m_rank[slot] = static_cast<uint32>(pos + 1); // row 0 has NULL key
+        std::copy(m_sorted.data() + pos * m_key_length,
+                  m_sorted.data() + (pos + 1) * m_key_length,
+                  m_key.data() + slot * m_key_length);
+        pos = fill(pos + 1, 2 * slot + 1);
+    }
+    return pos;
+}
+
+void index_cache::commit(bool const int_key)
+{
+    SDL_ASSERT(!m_page.empty());
+    SDL_ASSERT(m_sorted.size() == (m_page.size() - 1) * m_key_length);
+    m_key.resize(m_page.size() * m_key_length); // slot 0 is not used
+    m_rank.resize(m_page.size());
+    size_t const count = fill(0, 1);
+    SDL_ASSERT(count == m_page.size() - 1);
+    (void)count;
+    if (int_key) {
+        m_int.resize(m_page.size());
+        for (size_t slot = 1; slot < m_page.size(); ++slot) {
+            m_int[slot] = integer_key(slot_key(slot), m_key_length);
+        }
+    }
+    std::vector<char>().swap(m_sorted);
+    m_page.shrink_to_fit();
+}
+
+size_t index_cache::memory_size() const
+{
+    return m_key.capacity() + m_sorted.capacity()
+        + m_int.capacity() * sizeof(int64)
+        + m_rank.capacity() * sizeof(uint32)
+        + m_page.capacity() * sizeof(pageFileID);
+}
+
+} // db
+} // sdl
+
+#if SDL_DEBUG
+namespace sdl {
+    namespace db {
+        namespace {
+            class unit_test {
+            public:
+                unit_test()
+                {
+                    SDL_TRACE_FILE;
+                    for (size_t n = 1; n < 20; ++n) { // rows with keys 0, 10, 20.. pointing to pages 0, 1, 2..
+                        index_cache test(sizeof(int32), n);
+                        for (uint32 i = 0; i < n; ++i) {
+                            int32 const key = i * 10;
+                            pageFileID id{};
+                            id.pageId = i;
+                            test.push_back(reinterpret_cast<char const *>(&key), id);
+                        }
+                        test.commit(true);
+                        SDL_ASSERT(test.size() == n);
+                        SDL_ASSERT(test.is_integer());
+                        for (int32 key = -1; key < int32(n * 10 + 10); ++key) {
+                            auto const id = test.find_page(
+                                [key](char const * p) { return index_cache::integer_key(p, sizeof(int32)) < key; },
+                                [key](char const * p) { return key < index_cache::integer_key(p, sizeof(int32)); });
+                            uint32 const expect = (key < 0) ? 0 : a_min<uint32>(key / 10, static_cast<uint32>(n - 1));
+                            SDL_ASSERT(id.pageId == expect);
+                            SDL_ASSERT(test.find_page(int64(key)).pageId == expect);
+                        }
+                    }
+                    for (size_t n = 0; n < 20; ++n) {
+                        std::vector<int> v(n);
+                        for (size_t i = 0; i < n; ++i) {
+                            v[i] = static_cast<int>(i / 2) * 2; // duplicates
+                        }
+                        for (int key = -1; key < static_cast<int>(n) + 2; ++key) {
+                            size_t const i = algo::branchless_lower_bound(n, [&v, key](size_t const j) {
+                                return v[j] < key;
+                            });
+                            SDL_ASSERT(i == size_t(std::lower_bound(v.begin(), v.end(), key) - v.begin()));
+                        }
+                    }
+                }
+            };
+            static unit_test s_test;
+        }
+    } // db
+} // sdl
+#endif //#if SV_DEBUG
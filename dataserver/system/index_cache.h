@@ -0,0 +1,114 @@
+// index_cache.h
+//
+#pragma once
+#ifndef __SDL_SYSTEM_INDEX_CACHE_H__
+#define __SDL_SYSTEM_INDEX_CACHE_H__
+
+#include "page_head.h"
+
+namespace sdl { namespace db {
+
+// In-memory copy of the lowest non-leaf level of a clustered index (rows pointing to leaf pages).
+// Keys of the whole level are sorted, so one search over them finds the same leaf page
+// as descent from the root. Keys are stored contiguously in Eytzinger (breadth-first) order:
+// first steps of the search share a few cache lines, no index page is touched.
+class index_cache : noncopyable {
+public:
+    index_cache(size_t key_length, size_t reserve);
+
+    // rows in key order; key of the first row is NULL (less than any key) and is not stored
+    void push_back(char const * key, pageFileID const &);
+    void commit(bool int_key = false); // after all rows are added; int_key: see cluster_index::is_integer_key
+
+    bool is_integer() const { // keys are also stored as int64
+        return !m_int.empty();
+    }
+    static int64 integer_key(char const * p, size_t key_length) { // int or bigint key
+        SDL_ASSERT((key_length == sizeof(int32)) || (key_length == sizeof(int64)));
+        if (key_length == sizeof(int32)) {
+            int32 v;
+            memcpy(&v, p, sizeof(v));
+            return v;
+        }
+        int64 v;
+        memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    size_t size() const { // number of rows
+        return m_page.size();
+    }
+    size_t key_length() const {
+        return m_key_length;
+    }
+    size_t memory_size() const; // approximate heap bytes
+
+    // entry_less(p) : key of row < search key; key_less(p) : search key < key of row;
+    // p points to key_length bytes of row key
+    template<class entry_less_type, class key_less_type>
+    pageFileID find_page(entry_less_type &&, key_less_type &&) const;
+    pageFileID find_page(int64) const; // is_integer()
+private:
+    pageFileID leaf_page(size_t slot, bool key_less) const; // slot found by search
+    size_t fill(size_t pos, size_t slot);
+    char const * slot_key(size_t slot) const {
+        return m_key.data() + slot * m_key_length;
+    }
+private:
+    size_t const m_key_length;
+    std::vector<char> m_sorted;     // keys of rows [1..size) in key order, released by commit()
+    std::vector<char> m_key;        // Eytzinger slot [1..size) => key
+    std::vector<int64> m_int;       // Eytzinger slot => integer key
+    std::vector<uint32> m_rank;     // Eytzinger slot => row
+    std::vector<pageFileID> m_page; // row => leaf page
+};
+
+using shared_index_cache = std::shared_ptr<index_cache const>;
+
+template<class entry_less_type, class key_less_type>
+pageFileID index_cache::find_page(entry_less_type && entry_less, key_less_type && key_less) const
+{
+    SDL_ASSERT(!m_page.empty());
+    SDL_ASSERT(m_sorted.empty());
+    size_t const n = m_page.size();
+    size_t slot = 1;
+    while (slot < n) { // Eytzinger slots [1..n)
+        slot = 2 * slot + (entry_less(slot_key(slot)) ? 1 : 0);
+    }
+    while (slot & 1) { // trailing right turns lead past lower bound
+        slot >>= 1;
+    }
+    slot >>= 1; // slot of first key >= search key, 0 if all keys are less
+    return leaf_page(slot, slot && key_less(slot_key(slot)));
+}
+
+inline pageFileID index_cache::leaf_page(size_t const slot, bool const key_less) const
+{
+    if (slot) {
+        size_t const row = m_rank[slot];
+        SDL_ASSERT(row && (row < m_page.size()));
+        return m_page[key_less ? (row - 1) : row];
+    }
+    return m_page.back();
+}
+
+inline pageFileID index_cache::find_page(int64 const key) const
+{
+    SDL_ASSERT(is_integer());
+    size_t const n = m_page.size();
+    int64 const * const data = m_int.data();
+    size_t slot = 1;
+    while (slot < n) {
+        slot = 2 * slot + (data[slot] < key);
+    }
+    while (slot & 1) {
+        slot >>= 1;
+    }
+    slot >>= 1;
+    return leaf_page(slot, slot && (key < data[slot]));
+}
+
+} // db
+} // sdl
+
+#endif // __SDL_SYSTEM_INDEX_CACHE_H__
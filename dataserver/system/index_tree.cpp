@@ -23,7 +23,7 @@ index_tree::index_page::index_page(index_tree const * t, page_head const * h, si
 //------------------------------------------------------------------------
 
 index_tree::index_tree(database const * p, shared_cluster_index const & h)
-    : this_db(p), cluster(h), key_length(h->key_length())
+    : this_db(p), cluster(h), key_length(h->key_length()), m_compare(*h)
 {
     SDL_ASSERT(this_db && cluster && root());
     SDL_ASSERT(root()->is_index());
@@ -202,8 +202,45 @@ size_t index_tree::index_page::find_slot(key_mem const m) const
     return i - 1; // last slot
 }
 
+size_t index_tree::index_page::lower_slot(key_mem const m, bool const after) const
+{
+    SDL_ASSERT(mem_size(m));
+    size_t const columns = tree->m_compare.prefix_columns(mem_size(m));
+    SDL_ASSERT(columns);
+    const index_page_key data(this->head);
+    index_page_row_key const * const null = head->data.prevPage ? nullptr : index_page_key(this->head).front();
+    size_t const i = data.lower_bound([this, &m, null, after, columns](index_page_row_key const * const x) {
+        if (x == null)
+            return true;
+        int const c = tree->m_compare.compare(get_key(x).first, m.first, columns);
+        return after ? (c <= 0) : (c < 0);
+    });
+    SDL_ASSERT(i <= data.size());
+    return i ? (i - 1) : 0; // last row ordered before prefix
+}
+
+pageFileID index_tree::lower_page(key_mem const m, bool const after) const
+{
+    SDL_ASSERT(m_compare.prefix_columns(mem_size(m)));
+    return find_page_if([&m, after](index_page const & p) -> pageFileID const & {
+        return p.row_page(p.lower_slot(m, after));
+    });
+}
+
 pageFileID index_tree::find_page(key_mem const m) const
 {
+    if (m_cache && (mem_size(m) == this->key_length)) {
+        size_t const len = this->key_length;
+        pageFileID const id = m_cache->is_integer() ?
+            m_cache->find_page(index_cache::integer_key(m.first, len)) :
+            m_cache->find_page(
+                [this, &m, len](char const * const p) { return key_less(key_mem(p, p + len), m); },
+                [this, &m, len](char const * const p) { return key_less(m, key_mem(p, p + len)); });
+        SDL_ASSERT_DEBUG_2(id == find_page_if([&m](index_page const & p) -> pageFileID const & {
+            return p.find_page(m);
+        }));
+        return id;
+    }
     if (mem_size(m) == this->key_length) {
         index_page p(this, root(), 0);
         while (1) {
@@ -258,138 +295,89 @@ pageFileID index_tree::min_page() const
     return id;
 }
 
-pageFileID index_tree::max_page() const
+std::vector<page_head const *>
+index_tree::index_pages() const
 {
-    auto const id = find_page_if([](index_page const & p){
-        return p.max_page();
-    });
-    SDL_ASSERT(id && !this_db->nextPageID(id));
-    return id;
+    std::vector<page_head const *> result;
+    page_head const * head = root(); // leftmost page of current level
+    while (head && head->is_index()) {
+        for (auto p = head; p; p = this_db->load_next_head(p)) {
+            result.push_back(p);
+        }
+        const index_page_key page(head);
+        const auto row = page.front();
+        const char * const p1 = &(row->data.key);
+        const auto id = reinterpret_cast<const pageFileID *>(p1 + key_length);
+        head = this_db->load_page_head(*id);
+        SDL_ASSERT(head);
+    }
+    return result;
 }
 
-int index_tree::sub_key_compare(size_t const i, key_mem const & x, key_mem const & y) const
+shared_index_cache index_tree::make_cache() const
 {
-    SDL_ASSERT(mem_size(x) == mem_size(y));
-    switch ((*cluster)[i].type) {
-    case scalartype::t_int:
-        if (auto px = index_key_cast<scalartype::t_int>(x)) {
-        if (auto py = index_key_cast<scalartype::t_int>(y)) {
-            if (cluster->is_descending(i)) {
-                std::swap(px, py);
-            }
-            if ((*px) < (*py)) return -1;
-            if ((*py) < (*px)) return 1;
-        }}
-        break;
-    case scalartype::t_bigint:
-        if (auto px = index_key_cast<scalartype::t_bigint>(x)) {
-        if (auto py = index_key_cast<scalartype::t_bigint>(y)) {
-            if (cluster->is_descending(i)) {
-                std::swap(px, py);
-            }
-            if ((*px) < (*py)) return -1;
-            if ((*py) < (*px)) return 1;
-        }}
-        break;
-    case scalartype::t_uniqueidentifier:
-        if (auto px = index_key_cast<scalartype::t_uniqueidentifier>(x)) {
-        if (auto py = index_key_cast<scalartype::t_uniqueidentifier>(y)) {
-            if (cluster->is_descending(i)) {
-                std::swap(px, py);
-            }
-            const int val = guid_t::compare(*px, *py);
-            if (val < 0) return -1;
-            if (val > 0) return 1;
-        }}
-        break;
-    case scalartype::t_char:
-        {
-            if (cluster->is_descending(i))
-                return ::memcmp(y.first, x.first, mem_size(x));
-            else
-                return ::memcmp(x.first, y.first, mem_size(x));
+    page_head const * head = root(); // leftmost page of current level
+    while (head && head->is_index()) {
+        pageFileID const id = index_page(this, head, 0).row_page(0);
+        page_head const * const child = this_db->load_page_head(id);
+        if (child && child->is_data()) {
+            break;
         }
-        break;
-    case scalartype::t_nchar:
-        {
-            SDL_ASSERT(!(mem_size(x) % 2));
-            const size_t N = mem_size(x) / 2;
-            nchar_t const * px = reinterpret_cast<nchar_t const *>(x.first);
-            nchar_t const * py = reinterpret_cast<nchar_t const *>(y.first);
-            if (cluster->is_descending(i)) {
-                std::swap(px, py);
-            }
-            return nchar_compare(px, py, N);
+        head = child;
+    }
+    if (!(head && head->is_index())) {
+        SDL_ASSERT(0);
+        return {};
+    }
+    std::shared_ptr<index_cache> result = std::make_shared<index_cache>(key_length, 0);
+    for (; head; head = this_db->load_next_head(head)) {
+        const index_page p(this, head, 0);
+        for (size_t i = 0; i < p.size(); ++i) {
+            result->push_back(p.row_key(i).first, p.row_page(i));
         }
-        break; 
-    default:
-        SDL_ASSERT(0); // not implemented
-        break;
     }
-    return 0; // keys are equal
+    if (!result->size()) {
+        SDL_ASSERT(0);
+        return {};
+    }
+    result->commit(cluster->is_integer_key());
+    return result;
+}
+
+pageFileID index_tree::max_page() const
+{
+    auto const id = find_page_if([](index_page const & p){
+        return p.max_page();
+    });
+    SDL_ASSERT(id && !this_db->nextPageID(id));
+    return id;
 }
 
-bool index_tree::key_less(key_mem x, key_mem y) const
+bool index_tree::key_less(key_mem const x, key_mem const y) const
 {
     SDL_ASSERT(mem_size(x) == this->key_length);
     SDL_ASSERT(mem_size(y) == this->key_length);
-    for (size_t i = 0; i < cluster->size(); ++i) {
-        size_t const sz = cluster->sub_key_length(i);
-        x.second = x.first + sz;
-        y.second = y.first + sz;
-        switch (sub_key_compare(i, x, y)) {
-        case -1 : return true;
-        case 1 : return false;
-        default:
-            break;
-        }
-        x.first = x.second;
-        y.first = y.second;
-    }
-    return false; // keys are equal
+    return m_compare.less(x.first, y.first);
 }
 
-bool index_tree::key_less(vector_mem_range_t const & x, key_mem y) const
+bool index_tree::key_less(vector_mem_range_t const & x, key_mem const y) const
 {
     SDL_ASSERT(mem_size(x) == this->key_length);
     SDL_ASSERT(mem_size(y) == this->key_length);
-    if (x.size() == cluster->size()) {
-        for (size_t i = 0; i < cluster->size(); ++i) {
-            size_t const sz = cluster->sub_key_length(i);
-            y.second = y.first + sz;
-            switch (sub_key_compare(i, x[i], y)) {
-            case -1 : return true;
-            case 1 : return false;
-            default:
-                break;
-            }
-            y.first = y.second;
-        }
-        return false; // keys are equal
+    if (x.size() == m_compare.size()) {
+        return m_compare.compare(x, y.first, m_compare.size()) < 0;
     }
     // key values are splitted ?
     throw_error<index_tree_error>("bad key");
     return false;
 }
 
-
-bool index_tree::key_less(key_mem x, vector_mem_range_t const & y) const
+bool index_tree::key_less(key_mem const x, vector_mem_range_t const & y) const
 {
     SDL_ASSERT(mem_size(x) == this->key_length);
     SDL_ASSERT(mem_size(y) == this->key_length);
-    if (y.size() == cluster->size()) {
-        for (size_t i = 0; i < cluster->size(); ++i) {
-            size_t const sz = cluster->sub_key_length(i);
-            x.second = x.first + sz;
-            switch (sub_key_compare(i, x, y[i])) {
-            case -1 : return true;
-            case 1 : return false;
-            default:
-                break;
-            }
-            x.first = x.second;
-        }
-        return false; // keys are equal
+    if (y.size() == m_compare.size()) {
+        return m_compare.compare(y, x.first, m_compare.size()) > 0;
     }
     // key values are splitted ?
     throw_error<index_tree_error>("bad key");
@@ -5,6 +5,8 @@
 #define __SDL_SYSTEM_INDEX_TREE_H__
 
 #include "primary_key.h"
+#include "index_cache.h"
+#include "key_compare.h"
 
 namespace sdl { namespace db { 
 
@@ -51,6 +53,7 @@ private:
         key_mem row_key(size_t) const;
         pageFileID const & row_page(size_t) const;
         size_t find_slot(key_mem) const;
+        size_t lower_slot(key_mem, bool) const;
         pageFileID const & find_page(key_mem) const;
         bool is_key_NULL() const;
     };
@@ -117,7 +120,6 @@ private:
         void load_prev(index_page &);
         bool is_end(index_page const &) const;
     };
-    int sub_key_compare(size_t, key_mem const &, key_mem const &) const;
 public:
     using row_iterator_value = row_access::value_type;
     using page_iterator_value = page_access::value_type;
@@ -134,12 +136,19 @@ public:
     bool key_less(key_mem, key_mem) const;
     bool key_less(vector_mem_range_t const &, key_mem) const;
     bool key_less(key_mem, vector_mem_range_t const &) const;
+    key_compare const & get_compare() const {
+        return m_compare;
+    }
 
     recordID get_RID(row_access::iterator const & it) const {
         return _rows.get_RID(it);
     }
     std::string type_key(key_mem) const; //diagnostic
-    pageFileID find_page(key_mem) const;    
+    pageFileID find_page(key_mem) const; // uses index_cache if it is set
+
+    // leaf page where keys ordered before prefix end (or first leaf page):
+    // before means key < prefix, or key <= prefix if after = true
+    pageFileID lower_page(key_mem prefix, bool after) const;
     
     template<class T>
     pageFileID find_page_t(T const & key) const;
@@ -147,6 +156,16 @@ public:
     pageFileID min_page() const;
     pageFileID max_page() const;
 
+    std::vector<page_head const *> index_pages() const; // all pages above leaf level, root first
+
+    shared_index_cache make_cache() const; // copy of lowest non-leaf level
+    void set_cache(shared_index_cache const & p) {
+        SDL_ASSERT(!p || (p->key_length() == key_length));
+        m_cache = p;
+    }
+    shared_index_cache const & get_cache() const {
+        return m_cache;
+    }
     row_access _rows{ this };
     page_access _pages{ this };
 
@@ -154,6 +173,8 @@ private:
     database const * const this_db;
     shared_cluster_index const cluster;
     size_t const key_length;
+    key_compare const m_compare;
+    shared_index_cache m_cache;
 };
 
 using shared_index_tree = std::shared_ptr<index_tree>;
@@ -6,6 +6,7 @@
 
 #include "datapage.h"
 #include "database_fwd.h"
+#include "index_cache.h"
 
 namespace sdl { namespace db { namespace make {
 
@@ -146,6 +147,7 @@ public:
     }
     pageFileID find_page(key_ref) const;
     pageFileID first_page(first_key const &) const;
+    static pageFileID find_page(index_cache const &, key_ref); // without reading index pages
 
     pageFileID min_page() const;
     pageFileID max_page() const;
@@ -190,6 +190,15 @@ pageFileID index_tree<KEY_TYPE>::find_page(key_ref m) const
     return{};
 }
 
+template<typename KEY_TYPE>
+pageFileID index_tree<KEY_TYPE>::find_page(index_cache const & cache, key_ref m)
+{
+    SDL_ASSERT(cache.key_length() == key_length);
+    return cache.find_page(
+        [&m](char const * const p) { return key_less(*reinterpret_cast<key_type const *>(p), m); },
+        [&m](char const * const p) { return key_less(m, *reinterpret_cast<key_type const *>(p)); });
+}
+
 template<typename KEY_TYPE>
 pageFileID index_tree<KEY_TYPE>::first_page(first_key const & m) const
 {
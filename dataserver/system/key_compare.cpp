@@ -0,0 +1,277 @@
+// key_compare.cpp
+//
+#include "common/common.h"
+#include "key_compare.h"
+#include "nonclustered_index.h"
+
+namespace sdl { namespace db {
+
+namespace {
+
+struct datetime_key { // days, then ticks
+    int32 days;
+    uint32 ticks;
+};
+
+inline bool operator < (datetime_key const & x, datetime_key const & y) {
+    if (x.days < y.days) return true;
+    if (y.days < x.days) return false;
+    return x.ticks < y.ticks;
+}
+
+template<class T> inline
+T read_key(char const * const p) { // key memory is not aligned
+    T value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+template<> inline
+datetime_key read_key<datetime_key>(char const * const p) {
+    datetime_t value;
+    memcpy(&value, p, sizeof(value));
+    return { value.days, value.ticks };
+}
+
+template<class T>
+int compare_value(char const * const x, char const * const y, size_t) {
+    T const a = read_key<T>(x);
+    T const b = read_key<T>(y);
+    if (a < b) return -1;
+    if (b < a) return 1;
+    return 0;
+}
+
+int compare_guid(char const * const x, char const * const y, size_t) {
+    int const val = guid_t::compare(read_key<guid_t>(x), read_key<guid_t>(y));
+    return (val < 0) ? -1 : ((val > 0) ? 1 : 0);
+}
+
+int compare_char(char const * const x, char const * const y, size_t const length) {
+    int const val = ::memcmp(x, y, length);
+    return (val < 0) ? -1 : ((val > 0) ? 1 : 0);
+}
+
+int compare_nchar(char const * const x, char const * const y, size_t const length) {
+    SDL_ASSERT(!(length % 2));
+    return nchar_compare(
+        reinterpret_cast<nchar_t const *>(x),
+        reinterpret_cast<nchar_t const *>(y), length / 2);
+}
+
+int compare_unsupported(char const *, char const *, size_t) {
+    SDL_ASSERT(!"key_compare");
+    return 0; // keys are equal
+}
+
+template<int(*compare)(char const *, char const *, size_t)>
+int compare_descending(char const * const x, char const * const y, size_t const length) {
+    return compare(y, x, length);
+}
+
+template<class T0>
+bool less_1(key_compare const &, char const * const x, char const * const y) {
+    return read_key<T0>(x) < read_key<T0>(y);
+}
+
+template<class T0, class T1>
+bool less_2(key_compare const & c, char const * const x, char const * const y) {
+    T0 const a = read_key<T0>(x);
+    T0 const b = read_key<T0>(y);
+    if (a < b) return true;
+    if (b < a) return false;
+    return read_key<T1>(x + c.offset(1)) < read_key<T1>(y + c.offset(1));
+}
+
+bool less_n(key_compare const & c, char const * const x, char const * const y) {
+    return c.compare(x, y, c.size()) < 0;
+}
+
+enum class shape_type { none, int32, int64, datetime };
+
+template<class index_type>
+shape_type get_shape(index_type const & index, size_t const i) {
+    if (index.is_descending(i)) {
+        return shape_type::none;
+    }
+    switch (index[i].type) {
+    case scalartype::t_int      : return shape_type::int32;
+    case scalartype::t_bigint   : return shape_type::int64;
+    case scalartype::t_datetime : return shape_type::datetime;
+    default:
+        return shape_type::none;
+    }
+}
+
+using less_fn = bool(*)(key_compare const &, char const *, char const *);
+
+template<class T0>
+less_fn make_less_2(shape_type const t1) {
+    switch (t1) {
+    case shape_type::int32      : return less_2<T0, int32>;
+    case shape_type::int64      : return less_2<T0, int64>;
+    case shape_type::datetime   : return less_2<T0, datetime_key>;
+    default:
+        return less_n;
+    }
+}
+
+} // namespace
+
+key_compare::key_compare(cluster_index const & index)
+{
+    init(index);
+}
+
+key_compare::key_compare(nonclustered_index const & index)
+{
+    init(index);
+}
+
+template<class index_type>
+void key_compare::init(index_type const & index)
+{
+    m_less = make_less(index);
+    m_column.resize(index.size());
+    for (size_t i = 0; i < index.size(); ++i) {
+        column_type & col = m_column[i];
+        col.offset = m_key_length;
+        col.length = index.sub_key_length(i);
+        col.compare = make_compare(index[i].type, index.is_descending(i));
+        m_key_length += col.length;
+    }
+    SDL_ASSERT(m_key_length == index.key_length());
+}
+
+key_compare::compare_fn
+key_compare::make_compare(scalartype::type const type, bool const descending)
+{
+    switch (type) {
+    case scalartype::t_int:
+        return descending ? compare_descending<compare_value<int32>> : compare_value<int32>;
+    case scalartype::t_bigint:
+        return descending ? compare_descending<compare_value<int64>> : compare_value<int64>;
+    case scalartype::t_smallint:
+        return descending ? compare_descending<compare_value<int16>> : compare_value<int16>;
+    case scalartype::t_float:
+        return descending ? compare_descending<compare_value<double>> : compare_value<double>;
+    case scalartype::t_real:
+        return descending ? compare_descending<compare_value<float>> : compare_value<float>;
+    case scalartype::t_datetime:
+        return descending ? compare_descending<compare_value<datetime_key>> : compare_value<datetime_key>;
+    case scalartype::t_uniqueidentifier:
+        return descending ? compare_descending<compare_guid> : compare_guid;
+    case scalartype::t_char:
+        return descending ? compare_descending<compare_char> : compare_char;
+    case scalartype::t_nchar:
+        return descending ? compare_descending<compare_nchar> : compare_nchar;
+    default:
+        return compare_unsupported;
+    }
+}
+
+template<class index_type>
+key_compare::less_fn
+key_compare::make_less(index_type const & index)
+{
+    shape_type const t0 = get_shape(index, 0);
+    if (index.size() == 1) {
+        switch (t0) {
+        case shape_type::int32      : return less_1<int32>;
+        case shape_type::int64      : return less_1<int64>;
+        case shape_type::datetime   : return less_1<datetime_key>;
+        default:
+            break;
+        }
+    }
+    else if (index.size() == 2) {
+        shape_type const t1 = get_shape(index, 1);
+        switch (t0) {
+        case shape_type::int32      : return make_less_2<int32>(t1);
+        case shape_type::int64      : return make_less_2<int64>(t1);
+        case shape_type::datetime   : return make_less_2<datetime_key>(t1);
+        default:
+            break;
+        }
+    }
+    return less_n;
+}
+
+bool key_compare::is_supported(scalartype::type const type)
+{
+    return make_compare(type, false) != compare_unsupported;
+}
+
+size_t key_compare::prefix_columns(size_t const length) const
+{
+    for (size_t i = 0; i < size(); ++i) {
+        if (m_column[i].offset + m_column[i].length == length) {
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+int key_compare::compare(char const * const x, char const * const y, size_t const columns) const
+{
+    SDL_ASSERT(columns <= size());
+    for (size_t i = 0; i < columns; ++i) {
+        column_type const & col = m_column[i];
+        if (int const val = col.compare(x + col.offset, y + col.offset, col.length)) {
+            return val;
+        }
+    }
+    return 0;
+}
+
+int key_compare::compare(vector_mem_range_t const & x, char const * const y, size_t const columns) const
+{
+    SDL_ASSERT(columns <= size());
+    SDL_ASSERT(x.size() == size());
+    for (size_t i = 0; i < columns; ++i) {
+        column_type const & col = m_column[i];
+        SDL_ASSERT(mem_size(x[i]) == col.length);
+        if (int const val = col.compare(x[i].first, y + col.offset, col.length)) {
+            return val;
+        }
+    }
+    return 0;
+}
+
+} // db
+} // sdl
+
+#if SDL_DEBUG
+namespace sdl {
+    namespace db {
+        namespace {
+            class unit_test {
+            public:
+                unit_test()
+                {
+                    SDL_TRACE_FILE;
+                    auto const ptr = [](void const * p) {
+                        return reinterpret_cast<char const *>(p);
+                    };
+                    int32 const i[] = { -1, 0, 1 };
+                    SDL_ASSERT(compare_value<int32>(ptr(i), ptr(i + 1), sizeof(int32)) == -1);
+                    SDL_ASSERT(compare_value<int32>(ptr(i + 2), ptr(i + 1), sizeof(int32)) == 1);
+                    SDL_ASSERT(compare_value<int32>(ptr(i), ptr(i), sizeof(int32)) == 0);
+                    SDL_ASSERT(compare_descending<compare_value<int32>>(ptr(i), ptr(i + 1), sizeof(int32)) == 1);
+                    datetime_t d[2];
+                    d[0].days = 1; d[0].ticks = 100;
+                    d[1].days = 2; d[1].ticks = 0;
+                    SDL_ASSERT(compare_value<datetime_key>(ptr(d), ptr(d + 1), sizeof(datetime_t)) == -1);
+                    d[1].days = 1;
+                    SDL_ASSERT(compare_value<datetime_key>(ptr(d), ptr(d + 1), sizeof(datetime_t)) == 1);
+                    char const a[] = "ab";
+                    char const b[] = "ac";
+                    SDL_ASSERT(compare_char(a, b, 2) == -1);
+                    SDL_ASSERT(compare_descending<compare_char>(a, b, 2) == 1);
+                }
+            };
+            static unit_test s_test;
+        }
+    } // db
+} // sdl
+#endif //#if SV_DEBUG
@@ -0,0 +1,67 @@
+// key_compare.h
+//
+#pragma once
+#ifndef __SDL_SYSTEM_KEY_COMPARE_H__
+#define __SDL_SYSTEM_KEY_COMPARE_H__
+
+#include "primary_key.h"
+
+namespace sdl { namespace db {
+
+class nonclustered_index;
+
+// Comparator of cluster keys built once from column types and sort order of cluster_index.
+// Every column gets a typed compare function; keys of one or two ascending integer columns
+// get a specialized less function, so comparison does not switch on scalar type.
+// Keys are compared in index order: descending columns are inverted.
+// Keys of nonclustered_index are compared the same way.
+class key_compare : noncopyable {
+public:
+    explicit key_compare(cluster_index const &);
+    explicit key_compare(nonclustered_index const &);
+
+    size_t size() const { // number of columns
+        return m_column.size();
+    }
+    size_t key_length() const {
+        return m_key_length;
+    }
+    size_t offset(size_t i) const { // of column in key
+        SDL_ASSERT(i < size());
+        return m_column[i].offset;
+    }
+    // number of first columns with given memory size, 0 if size is not prefix of key
+    size_t prefix_columns(size_t length) const;
+
+    bool less(char const * x, char const * y) const { // full keys
+        return m_less(*this, x, y);
+    }
+    int compare_column(size_t i, char const * x, char const * y) const { // -1, 0, 1
+        SDL_ASSERT(i < size());
+        return m_column[i].compare(x, y, m_column[i].length);
+    }
+    int compare(char const * x, char const * y, size_t columns) const; // first columns
+    int compare(vector_mem_range_t const & x, char const * y, size_t columns) const; // x split by columns
+
+    static bool is_supported(scalartype::type); // column type has compare function
+private:
+    using compare_fn = int(*)(char const *, char const *, size_t);
+    using less_fn = bool(*)(key_compare const &, char const *, char const *);
+    struct column_type {
+        size_t offset;
+        size_t length;
+        compare_fn compare;
+    };
+    static compare_fn make_compare(scalartype::type, bool descending);
+    template<class index_type> static less_fn make_less(index_type const &);
+    template<class index_type> void init(index_type const &);
+private:
+    std::vector<column_type> m_column;
+    size_t m_key_length = 0;
+    less_fn m_less;
+};
+
+} // db
+} // sdl
+
+#endif // __SDL_SYSTEM_KEY_COMPARE_H__
@@ -0,0 +1,257 @@
+// key_filter.cpp
+//
+#include "common/common.h"
+#include "key_filter.h"
+#include <fstream>
+#include <cstdio>
+
+namespace sdl { namespace db {
+
+#pragma pack(push, 1)
+struct key_filter::header_type {
+    char magic[8];
+    uint32 version;
+    file_key key;
+    int32 table_id;
+    uint32 hash_count;
+    uint64 key_count;
+    uint64 block_count;
+};
+#pragma pack(pop)
+
+namespace {
+
+const char sidecar_magic[8] = { 'S', 'D', 'L', 'K', 'E', 'Y', 'F', 'L' };
+const uint32 sidecar_version = 1;
+
+const uint64 fnv_offset = 14695981039346656037ULL;
+const uint64 fnv_prime = 1099511628211ULL;
+
+inline uint64 fnv_append(uint64 h, char const * p, char const * const last) {
+    for (; p != last; ++p) {
+        h ^= static_cast<uint8>(*p);
+        h *= fnv_prime;
+    }
+    return h;
+}
+
+inline uint64 mix64(uint64 h) { // MurmurHash3 finalizer
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+inline uint64 bit_hash(uint64 const hash) { // bits inside block are taken from second hash
+    return mix64(hash ^ 0x9e3779b97f4a7c15ULL);
+}
+
+size_t block_count(size_t const key_count, size_t const memory_limit, size_t const block_bits) {
+    uint64 const bits = uint64(a_max<size_t>(key_count, 1)) * key_filter::bits_per_key;
+    size_t count = static_cast<size_t>((bits + block_bits - 1) / block_bits);
+    if (memory_limit) {
+        count = a_min(count, memory_limit * 8 / block_bits);
+    }
+    return a_max<size_t>(count, 1);
+}
+
+size_t hash_count(size_t const key_count, size_t const bits) { // k = ln2 * bits per key
+    size_t const k = static_cast<size_t>(0.693 * bits / a_max<size_t>(key_count, 1) + 0.5);
+    return a_min<size_t>(a_max<size_t>(k, 1), 7); // 9 bits of second hash per probe
+}
+
+} // namespace
+
+key_filter::key_filter(size_t const key_count, size_t const hash_count, size_t const block_count)
+    : m_key_count(key_count)
+    , m_hash_count(hash_count)
+    , m_block_count(block_count)
+    , m_bits(block_count * block_words)
+    , m_lookup(0)
+    , m_negative(0)
+    , m_false_positive(0)
+{
+    SDL_ASSERT(m_block_count);
+    SDL_ASSERT(m_hash_count && (m_hash_count <= 7));
+}
+
+key_filter::key_filter(size_t const key_count, size_t const memory_limit)
+    : key_filter(key_count,
+        db::hash_count(key_count, db::block_count(key_count, memory_limit, block_words * 64) * block_words * 64),
+        db::block_count(key_count, memory_limit, block_words * 64))
+{
+}
+
+bool key_filter::is_enough(size_t const key_count, size_t const memory_limit)
+{
+    return !memory_limit || (uint64(memory_limit) * 8 >= uint64(key_count) * min_bits_per_key);
+}
+
+uint64 key_filter::hash(key_mem const & key)
+{
+    return mix64(fnv_append(fnv_offset, key.first, key.second));
+}
+
+uint64 key_filter::hash(vector_mem_range_t const & key)
+{
+    uint64 h = fnv_offset;
+    for (auto const & m : key) {
+        h = fnv_append(h, m.first, m.second);
+    }
+    return mix64(h);
+}
+
+void key_filter::insert(uint64 const hash)
+{
+    uint64 * const p = m_bits.data() + (hash % m_block_count) * block_words;
+    uint64 bits = bit_hash(hash);
+    for (size_t i = 0; i < m_hash_count; ++i, bits >>= 9) {
+        size_t const bit = bits & 511;
+        p[bit >> 6] |= uint64(1) << (bit & 63);
+    }
+}
+
+bool key_filter::may_contain(uint64 const hash) const
+{
+    uint64 const * const p = block(hash);
+    uint64 bits = bit_hash(hash);
+    for (size_t i = 0; i < m_hash_count; ++i, bits >>= 9) {
+        size_t const bit = bits & 511;
+        if (!(p[bit >> 6] & (uint64(1) << (bit & 63)))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+key_filter::stat_type key_filter::get_stat() const
+{
+    stat_type s;
+    s.lookup = m_lookup.load();
+    s.negative = m_negative.load();
+    s.false_positive = m_false_positive.load();
+    return s;
+}
+
+std::string key_filter::sidecar_name(const std::string & fname, schobj_id const id)
+{
+    return fname + ".keyfilter." + std::to_string(id._32);
+}
+
+std::unique_ptr<key_filter>
+key_filter::load(const std::string & fname, schobj_id const id, file_key const & key)
+{
+    std::ifstream in(sidecar_name(fname, id), std::ifstream::in | std::ifstream::binary);
+    if (!in.is_open()) {
+        return {}; // not created yet
+    }
+    header_type h;
+    if (!in.read(reinterpret_cast<char *>(&h), sizeof(h))) {
+        SDL_WARNING(!"bad key filter");
+        return {};
+    }
+    if (::memcmp(h.magic, sidecar_magic, sizeof(sidecar_magic)) ||
+        (h.version != sidecar_version) ||
+        (h.table_id != id._32) ||
+        !h.block_count || !h.hash_count || (h.hash_count > 7)) {
+        SDL_WARNING(!"bad key filter");
+        return {};
+    }
+    if (::memcmp(&h.key, &key, sizeof(key))) {
+        return {}; // database is changed
+    }
+    std::unique_ptr<key_filter> result(new key_filter(
+        static_cast<size_t>(h.key_count),
+        static_cast<size_t>(h.hash_count),
+        static_cast<size_t>(h.block_count)));
+    std::vector<uint64> & bits = result->m_bits;
+    if (!in.read(reinterpret_cast<char *>(bits.data()), bits.size() * sizeof(uint64)) ||
+        (in.peek() != std::ifstream::traits_type::eof())) {
+        SDL_WARNING(!"bad key filter");
+        return {};
+    }
+    return result;
+}
+
+bool key_filter::write(const std::string & fname, schobj_id const id, file_key const & key) const
+{
+    const std::string name = sidecar_name(fname, id);
+    const std::string temp = name + ".tmp";
+    try {
+        {
+            std::ofstream out(temp, std::ofstream::out | std::ofstream::trunc | std::ofstream::binary);
+            throw_error_if<key_filter_error>(!out.is_open(), "cannot create key filter");
+            header_type h;
+            memset_zero(h);
+            ::memcpy(h.magic, sidecar_magic, sizeof(sidecar_magic));
+            h.version = sidecar_version;
+            h.key = key;
+            h.table_id = id._32;
+            h.hash_count = static_cast<uint32>(m_hash_count);
+            h.key_count = m_key_count;
+            h.block_count = m_block_count;
+            out.write(reinterpret_cast<char const *>(&h), sizeof(h));
+            out.write(reinterpret_cast<char const *>(m_bits.data()), m_bits.size() * sizeof(uint64));
+            throw_error_if<key_filter_error>(!out.good(), "cannot write key filter");
+        }
+        std::remove(name.c_str()); // rename does not replace existing file on Windows
+        throw_error_if<key_filter_error>(std::rename(temp.c_str(), name.c_str()) != 0, "cannot rename key filter");
+        return true;
+    }
+    catch (sdl_exception & e) {
+        (void)e;
+        SDL_TRACE("key_filter: ", e.what());
+        std::remove(temp.c_str());
+    }
+    return false;
+}
+
+} // db
+} // sdl
+
+#if SDL_DEBUG
+namespace sdl {
+    namespace db {
+        namespace {
+            class unit_test {
+            public:
+                unit_test()
+                {
+                    SDL_TRACE_FILE;
+                    auto const key = [](int32 const & k) {
+                        char const * const p = reinterpret_cast<char const *>(&k);
+                        return key_filter::key_mem(p, p + sizeof(k));
+                    };
+                    size_t const count = 1000;
+                    key_filter test(count, 0);
+                    SDL_ASSERT(test.hash_count() == 7);
+                    for (int32 i = 0; i < int32(count); ++i) {
+                        test.insert(key_filter::hash(key(i * 2)));
+                    }
+                    size_t positive = 0;
+                    for (int32 i = 0; i < int32(count); ++i) {
+                        SDL_ASSERT(test.lookup(key(i * 2))); // no false negatives
+                        if (test.lookup(key(i * 2 + 1))) {
+                            ++positive;
+                        }
+                    }
+                    SDL_ASSERT(positive < count / 20);
+                    SDL_ASSERT(test.get_stat().lookup == count * 2);
+                    SDL_ASSERT(test.get_stat().negative == count - positive);
+                    int32 const k = 123456;
+                    char const * const p = reinterpret_cast<char const *>(&k);
+                    vector_mem_range_t split;
+                    split.push_back({ p, p + 1 });
+                    split.push_back({ p + 1, p + sizeof(k) });
+                    SDL_ASSERT(key_filter::hash(split) == key_filter::hash(key(k)));
+                    SDL_ASSERT(key_filter::is_enough(count, 0));
+                    SDL_ASSERT(!key_filter::is_enough(count, count / 8));
+                }
+            };
+            static unit_test s_test;
+        }
+    } // db
+} // sdl
+#endif //#if SV_DEBUG
@@ -0,0 +1,89 @@
+// key_filter.h
+//
+#pragma once
+#ifndef __SDL_SYSTEM_KEY_FILTER_H__
+#define __SDL_SYSTEM_KEY_FILTER_H__
+
+#include "catalog_sidecar.h"
+#include <atomic>
+
+namespace sdl { namespace db {
+
+// Bloom filter over cluster keys of one table: key rejected by the filter is not in the table,
+// so lookup of missing key does not descend the index tree. Filter is split into blocks of one cache line;
+// key hash selects block and bits inside it, so one lookup reads one cache line.
+// Lookups are counted; caller reports keys which passed the filter but were not found (false positives).
+class key_filter : noncopyable {
+    using key_filter_error = sdl_exception_t<key_filter>;
+public:
+    using key_mem = mem_range_t;
+    using file_key = catalog_sidecar::key_type;
+    enum { bits_per_key = 10 };     // about 1% false positives
+    enum { min_bits_per_key = 4 };  // about 15% false positives, see is_enough
+    struct stat_type {
+        size_t lookup = 0;          // keys checked
+        size_t negative = 0;        // keys rejected, index is not searched
+        size_t false_positive = 0;  // keys passed filter but not found
+    };
+    // sized for key_count keys and at most memory_limit bytes; 0 = bits_per_key
+    key_filter(size_t key_count, size_t memory_limit);
+
+    // memory_limit allows at least min_bits_per_key
+    static bool is_enough(size_t key_count, size_t memory_limit);
+
+    static uint64 hash(key_mem const &);
+    static uint64 hash(vector_mem_range_t const &); // same as hash of joined memory
+
+    void insert(uint64 hash);
+    bool may_contain(uint64 hash) const;
+
+    bool lookup(key_mem const & key) const { // false if key is not in table
+        ++m_lookup;
+        if (may_contain(hash(key))) {
+            return true;
+        }
+        ++m_negative;
+        return false;
+    }
+    void false_positive() const { // key passed lookup but was not found
+        ++m_false_positive;
+    }
+    stat_type get_stat() const;
+
+    size_t key_count() const {
+        return m_key_count;
+    }
+    size_t hash_count() const { // bits per key
+        return m_hash_count;
+    }
+    size_t memory_size() const { // heap bytes
+        return m_bits.capacity() * sizeof(uint64);
+    }
+    // sidecar file next to database file (fname + ".keyfilter.<table id>"),
+    // used only while file_key matches the database (see catalog_sidecar)
+    static std::string sidecar_name(const std::string & fname, schobj_id);
+    static std::unique_ptr<key_filter> load(const std::string & fname, schobj_id, file_key const &); // nullptr if missing or stale
+    bool write(const std::string & fname, schobj_id, file_key const &) const;
+private:
+    enum { block_words = 8 }; // 64 bytes
+    struct header_type;
+    key_filter(size_t key_count, size_t hash_count, size_t block_count);
+    uint64 const * block(uint64 const hash) const {
+        return m_bits.data() + (hash % m_block_count) * block_words;
+    }
+private:
+    size_t const m_key_count;
+    size_t const m_hash_count;
+    size_t const m_block_count;
+    std::vector<uint64> m_bits;
+    mutable std::atomic<size_t> m_lookup;
+    mutable std::atomic<size_t> m_negative;
+    mutable std::atomic<size_t> m_false_positive;
+};
+
+using shared_key_filter = std::shared_ptr<key_filter const>;
+
+} // db
+} // sdl
+
+#endif // __SDL_SYSTEM_KEY_FILTER_H__
@@ -0,0 +1,256 @@
+// nonclustered_index.cpp
+//
+#include "common/common.h"
+#include "nonclustered_index.h"
+#include "database.h"
+
+namespace sdl { namespace db {
+
+nonclustered_index::nonclustered_index(
+    sysidxstats_row const * const idx,
+    page_head const * const root,
+    shared_usertable const & schema,
+    column_index && ci,
+    column_order && co,
+    shared_cluster_index const & cluster)
+    : idxstat(idx)
+    , m_root(root)
+    , m_schema(schema)
+    , m_index(std::move(ci))
+    , m_order(std::move(co))
+    , m_cluster(cluster)
+{
+    SDL_ASSERT(idxstat && m_root && m_schema);
+    SDL_ASSERT(m_index.size() == m_order.size());
+    SDL_ASSERT(this->size());
+
+    m_sub_key_length.resize(size());
+    for (size_t i = 0, end = size(); i < end; ++i) {
+        const size_t len = (*this)[i].fixed_size();
+        m_sub_key_length[i] = len;
+        m_key_length += len;
+    }
+    SDL_ASSERT(m_key_length);
+    if (m_cluster) {
+        column_index cluster(m_cluster->size());
+        std::vector<size_t> cluster_length(m_cluster->size());
+        for (size_t j = 0; j < m_cluster->size(); ++j) {
+            cluster[j] = m_cluster->col_ind(j);
+            cluster_length[j] = m_cluster->sub_key_length(j);
+        }
+        m_locator_length = make_locator(m_locator, m_index, m_sub_key_length, cluster, cluster_length);
+    }
+    else {
+        m_locator_length = sizeof(recordID);
+    }
+    m_compare.reset(new key_compare(*this));
+}
+
+size_t nonclustered_index::make_locator(locator_columns & locator,
+    column_index const & index, std::vector<size_t> const & sub_key_length,
+    column_index const & cluster, std::vector<size_t> const & cluster_sub_key_length)
+{
+    SDL_ASSERT(index.size() == sub_key_length.size());
+    SDL_ASSERT(cluster.size() == cluster_sub_key_length.size());
+    size_t key_length = 0;
+    for (size_t const len : sub_key_length) {
+        key_length += len;
+    }
+    size_t locator_length = 0;
+    locator.resize(cluster.size());
+    for (size_t j = 0; j < cluster.size(); ++j) {
+        locator_column & loc = locator[j];
+        loc.length = cluster_sub_key_length[j];
+        auto const found = std::find(index.begin(), index.end(), cluster[j]);
+        if (found != index.end()) {
+            size_t const pos = found - index.begin();
+            loc.offset = 0;
+            for (size_t i = 0; i < pos; ++i) {
+                loc.offset += sub_key_length[i];
+            }
+            SDL_ASSERT(sub_key_length[pos] == loc.length);
+        }
+        else {
+            loc.offset = key_length + locator_length;
+            locator_length += loc.length;
+        }
+    }
+    return locator_length;
+}
+
+void nonclustered_index::read_locator(char const * const leaf_key, locator_columns const & locator, std::vector<char> & key)
+{
+    size_t length = 0;
+    for (auto const & loc : locator) {
+        length += loc.length;
+    }
+    key.resize(length);
+    char * dest = key.data();
+    for (auto const & loc : locator) {
+        memcpy(dest, leaf_key + loc.offset, loc.length);
+        dest += loc.length;
+    }
+    SDL_ASSERT(dest == key.data() + key.size());
+}
+
+recordID nonclustered_index::get_RID(char const * const leaf_key) const
+{
+    SDL_ASSERT(is_heap());
+    recordID id;
+    memcpy(&id, leaf_key + m_key_length, sizeof(id));
+    return id;
+}
+
+void nonclustered_index::get_cluster_key(char const * const leaf_key, std::vector<char> & key) const
+{
+    SDL_ASSERT(!is_heap());
+    read_locator(leaf_key, m_locator, key);
+    SDL_ASSERT(key.size() == m_cluster->key_length());
+}
+
+//------------------------------------------------------------------------
+
+nonclustered_tree::nonclustered_tree(database const * const p, nonclustered_index const & index)
+    : this_db(p)
+    , m_index(index)
+    , m_compare(index.get_compare())
+{
+    SDL_ASSERT(this_db);
+    SDL_ASSERT(m_index.root()->is_index());
+}
+
+char const * nonclustered_tree::row_key(page_head const * const head, size_t const i)
+{
+    return &(index_page_key(head)[i]->data.key);
+}
+
+pageFileID const & nonclustered_tree::row_page(page_head const * const head, size_t const i)
+{
+    SDL_ASSERT(head->data.level);
+    char const * const row = reinterpret_cast<char const *>(index_page_key(head)[i]);
+    return *reinterpret_cast<pageFileID const *>(row + head->data.pminlen - sizeof(pageFileID));
+}
+
+size_t nonclustered_tree::lower_slot(page_head const * const head, key_mem const m, bool const after) const
+{
+    size_t const columns = m_compare.prefix_columns(mem_size(m));
+    SDL_ASSERT(columns);
+    const index_page_key data(head);
+    index_page_row_key const * const null = head->data.prevPage ? nullptr : data.front();
+    size_t const i = data.lower_bound([this, &m, null, after, columns](index_page_row_key const * const x) {
+        if (x == null)
+            return true;
+        int const c = m_compare.compare(&(x->data.key), m.first, columns);
+        return after ? (c <= 0) : (c < 0);
+    });
+    SDL_ASSERT(i <= data.size());
+    return i ? (i - 1) : 0; // last row ordered before prefix
+}
+
+nonclustered_tree::leaf_pos
+nonclustered_tree::seek(key_mem const lo, bool const inclusive) const
+{
+    page_head const * head = m_index.root();
+    while (head->data.level) {
+        SDL_ASSERT(head->data.pminlen == m_index.node_length());
+        if (!slot_array::size(head)) {
+            SDL_ASSERT(0);
+            return {};
+        }
+        size_t const slot = mem_size(lo) ? lower_slot(head, lo, !inclusive) : 0;
+        head = this_db->load_page_head(row_page(head, slot));
+        if (!head) {
+            SDL_ASSERT(0);
+            return {};
+        }
+    }
+    SDL_ASSERT(head->data.pminlen == m_index.leaf_length());
+    leaf_pos result;
+    result.page = head;
+    if (mem_size(lo) && slot_array::size(head)) {
+        size_t const columns = m_compare.prefix_columns(mem_size(lo));
+        SDL_ASSERT(columns);
+        result.slot = index_page_key(head).lower_bound([this, &lo, inclusive, columns](index_page_row_key const * const x) {
+            int const c = m_compare.compare(&(x->data.key), lo.first, columns);
+            return inclusive ? (c < 0) : (c <= 0);
+        });
+    }
+    skip_ghost(result);
+    return result;
+}
+
+void nonclustered_tree::skip_ghost(leaf_pos & p) const
+{
+    while (p.page) {
+        if (p.slot >= slot_array::size(p.page)) {
+            p.page = this_db->load_next_head(p.page);
+            p.slot = 0;
+        }
+        else if (index_page_key(p.page)[p.slot]->get_type() == recordType::ghost_index) {
+            ++p.slot;
+        }
+        else {
+            break;
+        }
+    }
+}
+
+void nonclustered_tree::next(leaf_pos & p) const
+{
+    SDL_ASSERT(p.page);
+    ++p.slot;
+    skip_ghost(p);
+}
+
+char const * nonclustered_tree::leaf_key(leaf_pos const & p) const
+{
+    SDL_ASSERT(p.page && (p.slot < slot_array::size(p.page)));
+    return row_key(p.page, p.slot);
+}
+
+} // db
+} // sdl
+
+#if SDL_DEBUG
+namespace sdl {
+    namespace db {
+        namespace {
+            class unit_test {
+            public:
+                unit_test()
+                {
+                    SDL_TRACE_FILE;
+                    using T = index_page_row_t<char>;
+                    static_assert(offsetof(T::data_type, key) == 1, "");
+                    static_assert(sizeof(recordID) == 8, "heap locator");
+                    using index = nonclustered_index;
+                    // index key (c2 int, c0 smallint), cluster key (c0 smallint, c1 bigint)
+                    index::locator_columns loc;
+                    size_t const length = index::make_locator(loc, { 2, 0 }, { 4, 2 }, { 0, 1 }, { 2, 8 });
+                    SDL_ASSERT(length == 8); // c0 is taken from index key
+                    SDL_ASSERT(loc.size() == 2);
+                    SDL_ASSERT((loc[0].offset == 4) && (loc[0].length == 2));
+                    SDL_ASSERT((loc[1].offset == 6) && (loc[1].length == 8));
+                    char leaf[4 + 2 + 8];
+                    int32 const c2 = 7;
+                    int16 const c0 = -3;
+                    int64 const c1 = 123456789012;
+                    memcpy(leaf, &c2, 4);
+                    memcpy(leaf + 4, &c0, 2);
+                    memcpy(leaf + 6, &c1, 8);
+                    std::vector<char> key;
+                    index::read_locator(leaf, loc, key);
+                    SDL_ASSERT(key.size() == 10);
+                    SDL_ASSERT(!memcmp(key.data(), &c0, 2));
+                    SDL_ASSERT(!memcmp(key.data() + 2, &c1, 8));
+                    // cluster key is not in index key
+                    size_t const length2 = index::make_locator(loc, { 2 }, { 4 }, { 1, 0 }, { 8, 2 });
+                    SDL_ASSERT(length2 == 10);
+                    SDL_ASSERT((loc[0].offset == 4) && (loc[1].offset == 12));
+                }
+            };
+            static unit_test s_test;
+        }
+    } // db
+} // sdl
+#endif //#if SV_DEBUG
@@ -0,0 +1,178 @@
+// nonclustered_index.h
+//
+#pragma once
+#ifndef __SDL_SYSTEM_NONCLUSTERED_INDEX_H__
+#define __SDL_SYSTEM_NONCLUSTERED_INDEX_H__
+
+#include "key_compare.h"
+#include "index_page.h"
+
+namespace sdl { namespace db {
+
+class database;
+
+// Nonclustered B-tree index of a table, key columns are read from sysiscols.
+// Leaf row holds index key and row locator: cluster key columns which are not in index key,
+// or RID of heap row. Non-leaf row of non-unique index holds index key, locator and child page.
+// Supported: fixed length key columns without included columns, table is heap or has unique clustered index.
+class nonclustered_index : noncopyable {
+public:
+    using column = usertable::column;
+    using column_ref = column const &;
+    using column_index = std::vector<size_t>;
+    using column_order = std::vector<sortorder>;
+public:
+    // cluster is nullptr if table is heap
+    nonclustered_index(sysidxstats_row const *, page_head const * root,
+        shared_usertable const &, column_index &&, column_order &&,
+        shared_cluster_index const & cluster);
+
+    sysidxstats_row const * const idxstat;
+
+    page_head const * root() const {
+        return m_root;
+    }
+    schobj_id get_id() const {
+        return m_schema->get_id();
+    }
+    std::string name() const {
+        return col_name_t(idxstat);
+    }
+    bool is_unique() const {
+        return idxstat->IsUnique();
+    }
+    bool is_heap() const {
+        return !m_cluster;
+    }
+    size_t size() const {
+        return m_index.size();
+    }
+    size_t col_ind(size_t i) const {
+        SDL_ASSERT(i < size());
+        return m_index[i];
+    }
+    sortorder col_ord(size_t i) const {
+        SDL_ASSERT(i < size());
+        return m_order[i];
+    }
+    bool is_descending(size_t i) const {
+        return (sortorder::DESC == col_ord(i));
+    }
+    column_ref operator[](size_t i) const {
+        SDL_ASSERT(i < size());
+        return (*m_schema)[m_index[i]];
+    }
+    size_t key_length() const {
+        return m_key_length;
+    }
+    size_t sub_key_length(size_t i) const {
+        SDL_ASSERT(i < size());
+        return m_sub_key_length[i];
+    }
+    size_t locator_length() const { // follows index key in leaf row
+        return m_locator_length;
+    }
+    size_t leaf_length() const { // pminlen of leaf page
+        return 1 + m_key_length + m_locator_length;
+    }
+    size_t node_length() const { // pminlen of non-leaf page
+        return 1 + m_key_length + (is_unique() ? 0 : m_locator_length) + sizeof(pageFileID);
+    }
+    key_compare const & get_compare() const {
+        return *m_compare;
+    }
+    // variable length column is stored in variable part of index row,
+    // key length and locator offset are computed for fixed length columns only
+    static bool is_key_column(column_ref c) {
+        return c.is_fixed() && key_compare::is_supported(c.type);
+    }
+    // leaf_key points to index key of leaf row
+    recordID get_RID(char const * leaf_key) const; // is_heap()
+    void get_cluster_key(char const * leaf_key, std::vector<char> &) const; // !is_heap()
+public:
+    struct locator_column { // cluster key column in leaf row
+        size_t offset; // from index key
+        size_t length;
+    };
+    using locator_columns = std::vector<locator_column>;
+    // cluster key column found in index key is not repeated in locator;
+    // returns length of locator which follows index key
+    static size_t make_locator(locator_columns &,
+        column_index const & index, std::vector<size_t> const & sub_key_length,
+        column_index const & cluster, std::vector<size_t> const & cluster_sub_key_length);
+    static void read_locator(char const * leaf_key, locator_columns const &, std::vector<char> &);
+private:
+    page_head const * const m_root;
+    shared_usertable const m_schema;
+    column_index const m_index;
+    column_order const m_order;
+    shared_cluster_index const m_cluster;
+    std::vector<size_t> m_sub_key_length;
+    locator_columns m_locator;
+    size_t m_key_length = 0;
+    size_t m_locator_length = 0;
+    std::unique_ptr<key_compare const> m_compare;
+};
+
+using shared_nonclustered_index = std::shared_ptr<nonclustered_index const>;
+using vector_nonclustered_index = std::vector<shared_nonclustered_index>;
+using shared_vector_nonclustered = std::shared_ptr<vector_nonclustered_index const>;
+
+// Walks leaf rows of nonclustered_index in index order.
+// Bounds are first columns of index key; empty bound does not limit the range.
+class nonclustered_tree : noncopyable {
+    using index_page_row_key = index_page_row_t<char>;
+    using index_page_key = datapage_t<index_page_row_key>;
+public:
+    using key_mem = mem_range_t;
+    struct leaf_pos {
+        page_head const * page = nullptr; // nullptr at end
+        size_t slot = 0;
+    };
+    nonclustered_tree(database const *, nonclustered_index const &);
+
+    nonclustered_index const & index() const {
+        return m_index;
+    }
+    leaf_pos seek(key_mem lo, bool inclusive) const; // first leaf row after lo
+    void next(leaf_pos &) const;
+    char const * leaf_key(leaf_pos const &) const;
+
+    template<class fun_type> // fun(char const * leaf_key) returns bool or break_or_continue
+    break_or_continue scan_range(key_mem lo, bool lo_inclusive, key_mem hi, bool hi_inclusive, fun_type &&) const;
+private:
+    static char const * row_key(page_head const *, size_t);
+    static pageFileID const & row_page(page_head const *, size_t);
+    size_t lower_slot(page_head const *, key_mem, bool after) const;
+    void skip_ghost(leaf_pos &) const;
+private:
+    database const * const this_db;
+    nonclustered_index const & m_index;
+    key_compare const & m_compare;
+};
+
+template<class fun_type>
+break_or_continue nonclustered_tree::scan_range(key_mem const lo, bool const lo_inclusive,
+                                                key_mem const hi, bool const hi_inclusive,
+                                                fun_type && fun) const {
+    size_t const hi_columns = mem_size(hi) ? m_compare.prefix_columns(mem_size(hi)) : 0;
+    SDL_ASSERT(!mem_size(hi) || hi_columns);
+    for (leaf_pos p = seek(lo, lo_inclusive); p.page; next(p)) {
+        char const * const key = leaf_key(p);
+        if (hi_columns) {
+            int const c = m_compare.compare(key, hi.first, hi_columns);
+            if (hi_inclusive ? (c > 0) : (c >= 0)) {
+                break;
+            }
+        }
+        if (is_break(fun(key))) {
+            return bc::break_;
+        }
+    }
+    return bc::continue_;
+}
+
+} // db
+} // sdl
+
+#endif // __SDL_SYSTEM_NONCLUSTERED_INDEX_H__
@@ -0,0 +1,61 @@
+// page_heatmap.cpp
+//
+#include "common/common.h"
+#include "page_heatmap.h"
+
+namespace sdl { namespace db {
+
+page_heatmap::page_heatmap(size_t const page_count)
+    : m_pageCount(page_count)
+    , m_count(new counter_type[page_count * shard_count])
+{
+    SDL_ASSERT(m_pageCount);
+    reset();
+}
+
+size_t page_heatmap::count(size_t const pageIndex) const
+{
+    SDL_ASSERT(pageIndex < m_pageCount);
+    size_t result = 0;
+    for (size_t i = 0; i < shard_count; ++i) {
+        result += m_count[i * m_pageCount + pageIndex].load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+void page_heatmap::reset()
+{
+    const size_t size = m_pageCount * shard_count;
+    for (size_t i = 0; i < size; ++i) {
+        m_count[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+} // db
+} // sdl
+
+#if SDL_DEBUG
+namespace sdl {
+    namespace db {
+        namespace {
+            class unit_test {
+            public:
+                unit_test()
+                {
+                    SDL_TRACE_FILE;
+                    page_heatmap test(16);
+                    test.record(0);
+                    test.record(15);
+                    test.record(15);
+                    SDL_ASSERT(test.count(0) == 1);
+                    SDL_ASSERT(test.count(1) == 0);
+                    SDL_ASSERT(test.count(15) == 2);
+                    test.reset();
+                    SDL_ASSERT(test.count(15) == 0);
+                }
+            };
+            static unit_test s_test;
+        }
+    } // db
+} // sdl
+#endif //#if SV_DEBUG
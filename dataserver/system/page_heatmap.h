@@ -0,0 +1,44 @@
+// page_heatmap.h
+//
+#pragma once
+#ifndef __SDL_SYSTEM_PAGE_HEATMAP_H__
+#define __SDL_SYSTEM_PAGE_HEATMAP_H__
+
+namespace sdl { namespace db {
+
+// Per-page access counters of one data file.
+// Counters are split into shards (shard major) and every thread increments its own shard
+// with relaxed atomic, so hot pages (index roots) do not bounce one cache line between threads.
+class page_heatmap : noncopyable {
+public:
+    enum { shard_count = 4 };
+    using counter_type = std::atomic<uint32>;
+    explicit page_heatmap(size_t page_count);
+
+    size_t page_count() const {
+        return m_pageCount;
+    }
+    void record(size_t const pageIndex) const {
+        SDL_ASSERT(pageIndex < m_pageCount);
+        m_count[shard() * m_pageCount + pageIndex].fetch_add(1, std::memory_order_relaxed);
+    }
+    size_t count(size_t pageIndex) const; // sum of shards
+    void reset();
+private:
+    static size_t shard();
+private:
+    const size_t m_pageCount;
+    std::unique_ptr<counter_type[]> m_count;
+};
+
+inline size_t page_heatmap::shard()
+{
+    static std::atomic<size_t> next(0);
+    static thread_local size_t const index = (next++) % shard_count;
+    return index;
+}
+
+} // db
+} // sdl
+
+#endif // __SDL_SYSTEM_PAGE_HEATMAP_H__
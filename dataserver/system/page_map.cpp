@@ -2,26 +2,406 @@
 //
 #include "common/common.h"
 #include "page_map.h"
+#include "filesys/file_map_detail.h"
+#include <thread>
 
 namespace sdl { namespace db {
 
 PageMapping::PageMapping(const std::string & fname)
+    : PageMapping(fname, database_param())
+{
+}
+
+PageMapping::PageMapping(const std::string & fname, database_param const & param)
     : filename(fname)
+    , m_randomOnly(param.random_only)
 {
     static_assert(page_size == 8 * 1024, "");
-    if (m_fmap.CreateMapView(fname.c_str())) {
-        const uint64 sz = m_fmap.GetFileSize();
-        const uint64 pp = sz / page_size;
-        SDL_ASSERT(!(sz % page_size));
-        SDL_ASSERT(pp < size_t(-1));
-        throw_error_if<PageMapping_error>((sz % page_size)!=0, "bad file size");
-        m_pageCount = static_cast<size_t>(pp);
+    throw_error_if<PageMapping_error>(param.is_windowed() && param.is_pool(), "windowed mapping and buffer pool are exclusive");
+    if (param.is_pool()) {
+        m_pool.reset(new page_pool(fname, param.pool_size));
+        init_page_count(m_pool->filesize());
+    }
+    else if (param.is_windowed()) {
+        throw_error_if<PageMapping_error>((param.window_size % page_size) != 0, "bad window size");
+        m_window.reset(new WindowMapping(fname.c_str(), param.window_size, param.window_limit));
+        init_page_count(m_window->GetFileSize());
+    }
+    else if (m_fmap.CreateMapView(fname.c_str())) {
+        m_address = static_cast<char const *>(m_fmap.GetFileView());
+        init_page_count(m_fmap.GetFileSize());
     }
     else {
         SDL_WARNING(false);
         m_pageCount = 0;
     }
     throw_error_if<PageMapping_error>(!m_pageCount, "empty file");
+    if (param.heatmap) {
+        m_heatmap.reset(new page_heatmap(m_pageCount));
+    }
+    m_fileId = load_page(pageIndex(0))->data.pageId.fileId; // file header page
+    if (m_randomOnly && !m_pool) {
+        if (m_window) {
+            m_window->SetDefaultAdvice(map_advice::random);
+        }
+        else {
+            file_map_detail::advise_view_of_file(m_address, m_fmap.GetFileSize(), map_advice::random);
+        }
+    }
+    init_files(param);
+}
+
+PageMapping::~PageMapping()
+{
+}
+
+void PageMapping::init_files(database_param const & param)
+{
+    if (param.data_files.empty()) {
+        return;
+    }
+    database_param file_param = param;
+    file_param.data_files.clear();
+    m_files.reserve(param.data_files.size());
+    for (auto const & fname : param.data_files) {
+        m_files.emplace_back(new PageMapping(fname, file_param));
+    }
+    auto insert = [this](PageMapping const * const p) {
+        const uint16 id = p->m_fileId;
+        throw_error_if<PageMapping_error>(!id, "bad file id");
+        if (id >= m_route.size()) {
+            m_route.resize(id + 1, nullptr);
+        }
+        throw_error_if<PageMapping_error>(m_route[id] != nullptr, "duplicate file id");
+        m_route[id] = p;
+    };
+    insert(this);
+    for (auto const & p : m_files) {
+        insert(p.get());
+    }
+}
+
+bool PageMapping::contains(void const * const p) const
+{
+    if (m_address) {
+        char const * const address = static_cast<char const *>(p);
+        return (m_address <= address) && (address < m_address + static_cast<uint64>(m_pageCount) * page_size);
+    }
+    if (m_window) {
+        return m_window->GetOffset(p) != uint64(-1);
+    }
+    return m_pool->contains(p);
+}
+
+void PageMapping::load_extent(pageFileID const & first, size_t const count) const
+{
+    if (first) {
+        PageMapping const * const file = route(first.fileId);
+        if (file->m_pool) {
+            file->m_pool->load_extent(first.pageId, count);
+        }
+        else {
+            file->advise(pageIndex(first.pageId), count, map_advice::willneed);
+        }
+    }
+}
+
+void PageMapping::advise(pageFileID const & first, size_t const count, map_advice const advice) const
+{
+    if (first) {
+        route(first.fileId)->advise(pageIndex(first.pageId), count, advice);
+    }
+}
+
+void PageMapping::advise(pageIndex const first, size_t count, map_advice const advice) const
+{
+    if (m_pool) { // pages are read explicitly
+        return;
+    }
+    if (m_randomOnly && (advice != map_advice::dontneed)) { // keep readahead disabled
+        return;
+    }
+    const size_t i = first.value();
+    if ((i < m_pageCount) && count) {
+        count = a_min(count, m_pageCount - i);
+        const uint64 offset = static_cast<uint64>(i) * page_size;
+        const uint64 size = static_cast<uint64>(count) * page_size;
+        if (m_address) {
+            file_map_detail::advise_view_of_file(m_address + offset, size, advice);
+        }
+        else {
+            m_window->Advise(offset, size, advice);
+        }
+    }
+    else {
+        SDL_ASSERT(i < m_pageCount);
+    }
+}
+
+void PageMapping::init_page_count(uint64 const sz)
+{
+    const uint64 pp = sz / page_size;
+    SDL_ASSERT(!(sz % page_size));
+    SDL_ASSERT(pp < size_t(-1));
+    throw_error_if<PageMapping_error>((sz % page_size)!=0, "bad file size");
+    m_pageCount = static_cast<size_t>(pp);
+}
+
+void PageMapping::touch_page(page_head const * const p)
+{
+    enum { step = 4 * 1024 }; // minimal system page
+    static_assert(!(page_size % step), "");
+    char const * const data = reinterpret_cast<char const *>(p);
+    volatile char c = 0;
+    for (size_t i = 0; i < page_size; i += step) {
+        c = data[i];
+    }
+    (void)c;
+}
+
+PageMapping::file_page_count
+PageMapping::page_counts() const
+{
+    file_page_count result;
+    result.reserve(file_count());
+    result.emplace_back(m_fileId, m_pageCount);
+    for (auto const & f : m_files) {
+        result.emplace_back(f->m_fileId, f->m_pageCount);
+    }
+    return result;
+}
+
+size_t PageMapping::populate(size_t const threads) const
+{
+    if (m_files.empty()) {
+        return populate_file(threads);
+    }
+    const size_t n = file_count();
+    const size_t file_threads = a_max<size_t>(threads / n, 1);
+    std::vector<size_t> count(n);
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < m_files.size(); ++i) {
+        workers.emplace_back([this, i, file_threads, &count](){
+            count[i + 1] = m_files[i]->populate_file(file_threads);
+        });
+    }
+    count[0] = populate_file(file_threads);
+    for (auto & w : workers) {
+        w.join();
+    }
+    size_t result = 0;
+    for (size_t c : count) {
+        result += c;
+    }
+    return result;
+}
+
+size_t PageMapping::populate_file(size_t threads) const
+{
+    if (m_pool) {
+        return 0;
+    }
+    size_t count = m_pageCount;
+    if (m_window && m_window->GetWindowLimit()) {
+        const uint64 limit = m_window->GetWindowLimit() * m_window->GetWindowSize() / page_size;
+        count = static_cast<size_t>(a_min<uint64>(count, limit));
+    }
+    threads = a_min(a_max<size_t>(threads, 1), count);
+    const size_t chunk = (count + threads - 1) / threads;
+    auto fun = [this, count, chunk](size_t const t) {
+        const size_t first = t * chunk;
+        const size_t last = a_min(first + chunk, count);
+        if (first < last) {
+            advise(pageIndex(static_cast<uint32>(first)), last - first, map_advice::willneed);
+            for (size_t i = first; i < last; ++i) { // windows are not kept mapped by populate
+                page_head const * const p = pin_page(pageIndex(static_cast<uint32>(i)));
+                touch_page(p);
+                if (m_window) {
+                    unpin_window(i);
+                }
+            }
+        }
+    };
+    std::vector<std::thread> workers;
+    for (size_t t = 1; t < threads; ++t) {
+        workers.emplace_back(fun, t);
+    }
+    fun(0);
+    for (auto & w : workers) {
+        w.join();
+    }
+    return count;
+}
+
+page_head const * PageMapping::pin_page(pageIndex const i) const
+{
+    if (m_pool) {
+        if (i.value() < m_pageCount) {
+            if (m_heatmap) {
+                m_heatmap->record(i.value());
+            }
+            return m_pool->pin_page(i.value());
+        }
+        throw_error<PageMapping_error>("page not found");
+    }
+    if (m_window) {
+        if (i.value() < m_pageCount) {
+            if (m_heatmap) {
+                m_heatmap->record(i.value());
+            }
+            return reinterpret_cast<page_head const *>(m_window->Pin(static_cast<uint64>(i.value()) * page_size));
+        }
+        throw_error<PageMapping_error>("page not found");
+    }
+    return load_page(i);
+}
+
+void PageMapping::unpin_window(size_t const i) const
+{
+    SDL_ASSERT(m_window && (i < m_pageCount));
+    m_window->Unpin(static_cast<uint64>(i) * page_size);
+}
+
+page_head const * PageMapping::pin_page(pageFileID const & id) const
+{
+    return id ? route(id.fileId)->pin_page(pageIndex(id.pageId)) : nullptr;
+}
+
+page_head const * PageMapping::load_resident(pageIndex const i) const
+{
+    if (m_pool) {
+        if (i.value() < m_pageCount) {
+            if (m_heatmap) {
+                m_heatmap->record(i.value());
+            }
+            return m_pool->load_resident(i.value());
+        }
+        throw_error<PageMapping_error>("page not found");
+    }
+    return load_page(i);
+}
+
+page_head const * PageMapping::load_resident(pageFileID const & id) const
+{
+    return id ? route(id.fileId)->load_resident(pageIndex(id.pageId)) : nullptr;
+}
+
+// page is not recorded in heatmap again;
+// if the frame was reused since load_page, page is read again and the result differs from argument
+page_head const * PageMapping::pin_loaded(page_head const * const p) const
+{
+    if (p) {
+        pageFileID const id = p->data.pageId;
+        PageMapping const * const file = route(id.fileId);
+        if (file->m_pool) {
+            return file->m_pool->pin_loaded(id.pageId);
+        }
+        if (file->m_window) {
+            SDL_ASSERT(file->m_window->GetOffset(p) == static_cast<uint64>(id.pageId) * page_size);
+            return reinterpret_cast<page_head const *>(file->m_window->Pin(static_cast<uint64>(id.pageId) * page_size));
+        }
+    }
+    return p;
+}
+
+void PageMapping::unpin_page(page_head const * const p) const
+{
+    if (p) {
+        PageMapping const * const file = route(p->data.pageId.fileId);
+        if (file->m_pool) {
+            file->m_pool->unpin_page(p);
+        }
+        else if (file->m_window) { // window is found by page id
+            SDL_ASSERT(file->m_window->GetOffset(p) == static_cast<uint64>(p->data.pageId.pageId) * page_size);
+            file->unpin_window(p->data.pageId.pageId);
+        }
+    }
+}
+
+PageMapping::heatmap_type
+PageMapping::heatmap() const
+{
+    heatmap_type result;
+    if (m_heatmap) {
+        for (size_t i = 0; i < m_pageCount; ++i) {
+            if (size_t const count = m_heatmap->count(i)) {
+                pageFileID id;
+                id.pageId = static_cast<uint32>(i);
+                id.fileId = m_fileId;
+                result.emplace_back(id, count);
+            }
+        }
+    }
+    for (auto const & f : m_files) {
+        auto const h = f->heatmap();
+        result.insert(result.end(), h.begin(), h.end());
+    }
+    return result;
+}
+
+void PageMapping::reset_heatmap() const
+{
+    if (m_heatmap) {
+        m_heatmap->reset();
+    }
+    for (auto const & f : m_files) {
+        f->reset_heatmap();
+    }
+}
+
+page_pool::stat_type PageMapping::pool_stat() const
+{
+    page_pool::stat_type result;
+    if (m_pool) {
+        result = m_pool->stat();
+    }
+    for (auto const & f : m_files) {
+        auto const s = f->pool_stat();
+        result.hit += s.hit;
+        result.miss += s.miss;
+        result.evicted += s.evicted;
+        result.resident += s.resident;
+        result.pinned += s.pinned;
+        result.frames += s.frames;
+        result.batch_reads += s.batch_reads;
+    }
+    return result;
+}
+
+uint64 PageMapping::resident_size() const
+{
+    uint64 result = 0;
+    if (m_address) {
+        result = file_map_detail::resident_size_of_file(m_address, m_fmap.GetFileSize());
+    }
+    else if (m_window) {
+        result = m_window->GetResidentSize();
+    }
+    for (auto const & f : m_files) {
+        result += f->resident_size();
+    }
+    return result;
+}
+
+void const * PageMapping::memory_offset(void const * const p) const
+{
+    for (auto const & f : m_files) {
+        if (f->contains(p)) {
+            return f->memory_offset(p);
+        }
+    }
+    if (m_pool) {
+        return reinterpret_cast<void const *>(m_pool->memory_offset(p));
+    }
+    if (m_window) {
+        const uint64 offset = m_window->GetOffset(p);
+        SDL_ASSERT(offset != uint64(-1));
+        return reinterpret_cast<void const *>(offset);
+    }
+    char const * const p1 = m_address;
+    char const * const p2 = static_cast<char const *>(p);
+    SDL_ASSERT(p2 >= p1);
+    return reinterpret_cast<void const *>(p2 - p1);
 }
 
 } // db
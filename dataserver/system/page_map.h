@@ -5,7 +5,11 @@
 #define __SDL_SYSTEM_PAGE_MAP_H__
 
 #include "page_head.h"
+#include "database_param.h"
 #include "filesys/file_map.h"
+#include "filesys/window_map.h"
+#include "page_pool.h"
+#include "page_heatmap.h"
 
 namespace sdl { namespace db {
 
@@ -15,36 +19,132 @@ class PageMapping : noncopyable
 
     enum { page_size = page_head::page_size };
 public:
-    const std::string filename;
+    const std::string filename; // primary data file
     explicit PageMapping(const std::string & fname);
+    PageMapping(const std::string & fname, database_param const &);
+    ~PageMapping();
 
+    size_t file_count() const
+    {
+        return m_files.size() + 1;
+    }
+    uint16 file_id() const // fileId of this data file
+    {
+        return m_fileId;
+    }
     bool is_open() const
     {
-        return m_fmap.IsFileMapped();
+        return m_address || m_window || m_pool;
+    }
+    bool is_windowed() const
+    {
+        return m_window.get() != nullptr;
     }
-    void const * start_address() const
+    bool is_pool() const
     {
-        return m_fmap.GetFileView();
+        return m_pool.get() != nullptr;
     }
-    size_t page_count() const
+    void const * start_address() const // nullptr if windowed or pool
+    {
+        return m_address;
+    }
+    void const * memory_offset(void const *) const; // diagnostic
+    size_t page_count() const // pages in primary data file
     {   
         return m_pageCount;
     }
+    size_t page_count(uint16 fileId) const
+    {
+        return route(fileId)->m_pageCount;
+    }
+    using file_page_count = std::vector<std::pair<uint16, size_t>>;
+    file_page_count page_counts() const; // fileId and page count of every data file, primary first
+    // page stays in buffer pool: rows and records keep raw pointers into it without pins
     page_head const * load_page(pageIndex) const;
     page_head const * load_page(pageFileID const &) const;
+
+    // page is never evicted from buffer pool (catalog pages and cached index roots)
+    page_head const * load_resident(pageIndex) const;
+    page_head const * load_resident(pageFileID const &) const;
+
+    // page is stable until unpin_page; it can be evicted from buffer pool or its window unmapped after that
+    page_head const * pin_page(pageIndex) const;
+    page_head const * pin_page(pageFileID const &) const;
+    page_head const * pin_loaded(page_head const *) const; // pin page returned by load_page
+    void unpin_page(page_head const *) const;
+    page_pool::stat_type pool_stat() const; // sum for all data files
+    uint64 resident_size() const; // resident bytes of mapped data files (RSS), 0 for buffer pool
+
+    // fault in mapped pages by several threads, returns number of pages touched;
+    // windowed mapping is populated up to window limit, buffer pool is not populated;
+    // data files are populated in parallel
+    size_t populate(size_t threads) const;
+    static void touch_page(page_head const *); // read every system page of the page
+
+    // access hint for pages [first, first + count)
+    void advise(pageIndex first, size_t count, map_advice) const;
+    void advise(pageFileID const & first, size_t count, map_advice) const;
+
+    // read pages [first, first + count) ahead of use with one request:
+    // buffer pool reads them with batched read, mapping issues willneed
+    void load_extent(pageFileID const & first, size_t count) const;
+    bool is_random_only() const
+    {
+        return m_randomOnly;
+    }
+    using heatmap_type = std::vector<std::pair<pageFileID, size_t>>;
+    heatmap_type heatmap() const; // accessed pages of all data files, empty if heatmap is disabled
+    void reset_heatmap() const;
+private:
+    void init_page_count(uint64 filesize);
+    void init_files(database_param const &);
+    PageMapping const * route(uint16 fileId) const;
+    size_t populate_file(size_t threads) const;
+    void unpin_window(size_t) const;
+    bool contains(void const *) const;
 private:
     size_t m_pageCount = 0;
+    uint16 m_fileId = 0;
+    bool m_randomOnly = false;
+    char const * m_address = nullptr; // whole file view
     FileMapping m_fmap;
+    std::unique_ptr<WindowMapping> m_window;
+    std::unique_ptr<page_pool> m_pool;
+    std::unique_ptr<page_heatmap> m_heatmap;
+    std::vector<std::unique_ptr<PageMapping>> m_files; // secondary data files
+    std::vector<PageMapping const *> m_route; // fileId => data file; empty if single file
 };
 
+inline PageMapping const *
+PageMapping::route(uint16 const fileId) const
+{
+    if (m_route.empty()) { // single file, fileId is not checked
+        return this;
+    }
+    if ((fileId < m_route.size()) && m_route[fileId]) {
+        return m_route[fileId];
+    }
+    SDL_TRACE("file not found: ", fileId);
+    throw_error<PageMapping_error>("file not found");
+    return nullptr;
+}
+
 inline page_head const *
 PageMapping::load_page(pageIndex const i) const
 {
     static_assert(page_size == (1 << 13), ""); // 8192 = 2^13
     const size_t pageIndex = i.value();
     if (pageIndex < m_pageCount) {
-        const char * const data = static_cast<const char *>(m_fmap.GetFileView());
-        return reinterpret_cast<page_head const *>(data + pageIndex * page_size);
+        if (m_heatmap) {
+            m_heatmap->record(pageIndex);
+        }
+        if (m_address) {
+            return reinterpret_cast<page_head const *>(m_address + pageIndex * page_size);
+        }
+        if (m_window) {
+            return reinterpret_cast<page_head const *>(m_window->GetAddress(static_cast<uint64>(pageIndex) * page_size));
+        }
+        return m_pool->load_page(pageIndex);
     }
     SDL_TRACE("page not found: ", pageIndex);
     throw_error<PageMapping_error>("page not found");
@@ -54,7 +154,7 @@ PageMapping::load_page(pageIndex const i) const
 inline page_head const *
 PageMapping::load_page(pageFileID const & id) const
 {
-    return id ? load_page(pageIndex(id.pageId)) : nullptr;
+    return id ? route(id.fileId)->load_page(pageIndex(id.pageId)) : nullptr;
 }
 
 } // db
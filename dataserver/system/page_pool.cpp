@@ -0,0 +1,371 @@
+// page_pool.cpp
+//
+#include "common/common.h"
+#include "page_pool.h"
+#include "page_test_file.h"
+
+namespace sdl { namespace db {
+
+page_pool::page_pool(const std::string & fname, size_t const frame_count)
+    : m_file(fname.c_str())
+    , m_frameCount(frame_count)
+{
+    const uint64 sz = m_file.GetFileSize();
+    throw_error_if<page_pool_error>(!m_frameCount, "empty buffer pool");
+    throw_error_if<page_pool_error>(!sz || (sz % page_size), "bad file size");
+    const uint64 pages = sz / page_size;
+    throw_error_if<page_pool_error>(pages >= none, "too many pages");
+    m_table.assign(static_cast<size_t>(pages), none);
+    m_frame.resize(m_frameCount);
+    m_data.reset(new char[m_frameCount * page_size]);
+    m_stat.frames = m_frameCount;
+}
+
+page_pool::~page_pool()
+{
+}
+
+page_pool::stat_type
+page_pool::stat() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stat;
+}
+
+size_t page_pool::frame_index(void const * const p) const
+{
+    char const * const address = static_cast<char const *>(p);
+    char const * const first = m_data.get();
+    if ((first <= address) && (address < first + m_frameCount * page_size)) {
+        return (address - first) / page_size;
+    }
+    return m_frameCount;
+}
+
+uint64 page_pool::memory_offset(void const * const p) const
+{
+    const size_t f = frame_index(p);
+    if (f < m_frameCount) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const uint32 page = m_frame[f].page;
+        if (page != none) {
+            return static_cast<uint64>(page) * page_size + 
+                (static_cast<char const *>(p) - frame_data(f));
+        }
+    }
+    SDL_ASSERT(0);
+    return uint64(-1);
+}
+
+// must be called under lock
+size_t page_pool::find_victim()
+{
+    const size_t f = try_victim();
+    throw_error_if<page_pool_error>(f == m_frameCount, "buffer pool exhausted");
+    return f;
+}
+
+// must be called under lock
+size_t page_pool::try_victim()
+{
+    if (m_used < m_frameCount) {
+        return m_used++;
+    }
+    for (size_t n = 0; n < 2 * m_frameCount; ++n) {
+        const size_t f = m_hand;
+        if (++m_hand == m_frameCount) {
+            m_hand = 0;
+        }
+        frame_t & fr = m_frame[f];
+        if (fr.resident || fr.pin || fr.loading) {
+            continue;
+        }
+        if (fr.ref) { // second chance
+            fr.ref = false;
+            continue;
+        }
+        return f;
+    }
+    return m_frameCount;
+}
+
+// must be called under lock
+void page_pool::keep(frame_t & fr, fetch_mode const mode)
+{
+    if (mode == fetch_mode::resident) {
+        if (!fr.resident) {
+            fr.resident = true;
+            ++m_stat.resident;
+        }
+    }
+    else {
+        if (!fr.pin++) {
+            ++m_stat.pinned;
+        }
+    }
+}
+
+page_head const * page_pool::fetch(size_t const page, fetch_mode const mode)
+{
+    if (page >= m_table.size()) {
+        throw_error<page_pool_error>("page not found");
+    }
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+        const uint32 f = m_table[page];
+        if (f == none) {
+            break;
+        }
+        frame_t & fr = m_frame[f];
+        if (fr.loading) {
+            m_cv.wait(lock);
+            continue;
+        }
+        if (mode != fetch_mode::repin) {
+            ++m_stat.hit;
+        }
+        fr.ref = true;
+        keep(fr, mode);
+        return reinterpret_cast<page_head const *>(frame_data(f));
+    }
+    ++m_stat.miss;
+    const size_t f = find_victim();
+    frame_t & fr = m_frame[f];
+    if (fr.page != none) {
+        SDL_ASSERT(m_table[fr.page] == f);
+        m_table[fr.page] = none;
+        ++m_stat.evicted;
+    }
+    fr = frame_t();
+    fr.page = static_cast<uint32>(page);
+    fr.loading = true;
+    m_table[page] = static_cast<uint32>(f);
+    lock.unlock();
+    const bool ok = m_file.ReadAt(static_cast<uint64>(page) * page_size, frame_data(f), page_size);
+    lock.lock();
+    fr.loading = false;
+    if (!ok) {
+        m_table[page] = none;
+        fr = frame_t();
+        m_cv.notify_all();
+        throw_error<page_pool_error>("read page failed");
+    }
+    fr.ref = true;
+    keep(fr, mode);
+    m_cv.notify_all();
+    return reinterpret_cast<page_head const *>(frame_data(f));
+}
+
+// pages can be evicted until load_page takes them; read ahead takes at most half of the pool,
+// so it does not push out pinned pages of running scans; it stops early if no frame is free
+size_t page_pool::load_extent(size_t const first, size_t count)
+{
+    if (first >= m_table.size()) {
+        SDL_ASSERT(0);
+        return 0;
+    }
+    count = a_min(a_min(count, m_table.size() - first), m_frameCount / 2);
+    size_t result = 0;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    size_t i = first;
+    while (i < first + count) {
+        if (m_table[i] != none) { // already loaded or loading
+            ++i;
+            continue;
+        }
+        const size_t start = i; // run of missing pages
+        std::vector<void *> buffers;
+        std::vector<size_t> frames;
+        for (; (i < first + count) && (m_table[i] == none); ++i) {
+            const size_t f = try_victim();
+            if (f == m_frameCount) { // read pages already marked as loading
+                count = i - first;
+                break;
+            }
+            frame_t & fr = m_frame[f];
+            if (fr.page != none) {
+                m_table[fr.page] = none;
+                ++m_stat.evicted;
+            }
+            fr = frame_t();
+            fr.page = static_cast<uint32>(i);
+            fr.loading = true;
+            m_table[i] = static_cast<uint32>(f);
+            buffers.push_back(frame_data(f));
+            frames.push_back(f);
+        }
+        if (frames.empty()) {
+            break;
+        }
+        m_stat.miss += frames.size();
+        ++m_stat.batch_reads;
+        lock.unlock();
+        const bool ok = m_file.ReadAt(static_cast<uint64>(start) * page_size, 
+            buffers.data(), buffers.size(), page_size);
+        lock.lock();
+        for (size_t k = 0; k < frames.size(); ++k) {
+            frame_t & fr = m_frame[frames[k]];
+            fr.loading = false;
+            if (ok) {
+                fr.ref = true;
+            }
+            else {
+                m_table[fr.page] = none;
+                fr = frame_t();
+            }
+        }
+        m_cv.notify_all();
+        throw_error_if<page_pool_error>(!ok, "read extent failed");
+        result += frames.size();
+    }
+    return result;
+}
+
+page_head const * page_pool::load_page(size_t const page)
+{
+    return fetch(page, fetch_mode::resident);
+}
+
+page_head const * page_pool::load_resident(size_t const page)
+{
+    return fetch(page, fetch_mode::resident);
+}
+
+page_head const * page_pool::pin_page(size_t const page)
+{
+    return fetch(page, fetch_mode::pin);
+}
+
+page_head const * page_pool::pin_loaded(size_t const page)
+{
+    return fetch(page, fetch_mode::repin);
+}
+
+void page_pool::unpin_page(page_head const * const p)
+{
+    const size_t f = frame_index(p);
+    if (f < m_frameCount) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        frame_t & fr = m_frame[f];
+        SDL_ASSERT(fr.pin);
+        if (fr.pin && !(--fr.pin)) {
+            --m_stat.pinned;
+        }
+    }
+    else {
+        SDL_ASSERT(0);
+    }
+}
+
+} // db
+} // sdl
+
+#if SDL_DEBUG
+namespace sdl {
+    namespace db {
+        namespace {
+            class unit_test {
+            public:
+                unit_test()
+                {
+                    SDL_TRACE_FILE;
+                    page_test_file const file("pool", 16);
+                    if (1) { // pinned scan of file larger than pool, hit and miss counters
+                        page_pool pool(file.name(), 4);
+                        for (size_t i = 0; i < 16; ++i) {
+                            page_head const * const p = pool.pin_page(i);
+                            SDL_ASSERT(page_test_file::check_page(p, i));
+                            pool.unpin_page(p);
+                        }
+                        auto const s = pool.stat();
+                        SDL_ASSERT((s.miss == 16) && !s.hit && (s.evicted == 12));
+                        SDL_ASSERT((s.frames == 4) && !s.pinned && !s.resident);
+                        page_head const * const last = pool.load_page(15);
+                        SDL_ASSERT(page_test_file::check_page(last, 15));
+                        SDL_ASSERT((pool.stat().hit == 1) && (pool.stat().resident == 1));
+                        page_head const * const p = pool.load_page(14);
+                        SDL_ASSERT(pool.pin_loaded(14) == p); // not counted as hit
+                        SDL_ASSERT((pool.stat().hit == 2) && (pool.stat().pinned == 1));
+                        pool.unpin_page(p);
+                        SDL_ASSERT(!pool.stat().pinned);
+                        for (size_t i = 0; i < 14; ++i) { // load_page frames stay under pressure
+                            pool.unpin_page(pool.pin_page(i));
+                        }
+                        SDL_ASSERT(pool.load_page(15) == last);
+                        SDL_ASSERT(pool.load_page(14) == p);
+                        SDL_ASSERT(page_test_file::check_page(last, 15));
+                        SDL_ASSERT((pool.stat().miss == 30) && (pool.stat().resident == 2));
+                    }
+                    if (1) { // pinned and resident frames are not evicted under pressure
+                        page_pool pool(file.name(), 4);
+                        page_head const * const pinned = pool.pin_page(1);
+                        page_head const * const resident = pool.load_resident(0);
+                        for (size_t n = 0; n < 3; ++n) {
+                            for (size_t i = 2; i < 16; ++i) {
+                                page_head const * const p = pool.pin_page(i);
+                                SDL_ASSERT(page_test_file::check_page(p, i));
+                                pool.unpin_page(p);
+                            }
+                        }
+                        SDL_ASSERT(page_test_file::check_page(pinned, 1));
+                        SDL_ASSERT(page_test_file::check_page(resident, 0));
+                        auto const s = pool.stat();
+                        SDL_ASSERT((s.pinned == 1) && (s.resident == 1) && (s.miss == 2 + 3 * 14));
+                        SDL_ASSERT(pool.pin_page(1) == pinned);
+                        SDL_ASSERT(pool.load_page(0) == resident);
+                        SDL_ASSERT((pool.stat().hit == 2) && (pool.stat().pinned == 1));
+                        pool.unpin_page(pinned);
+                        pool.unpin_page(pinned);
+                        SDL_ASSERT(!pool.stat().pinned);
+                        for (size_t i = 2; i < 16; ++i) { // frame of page 1 can be reused now
+                            pool.unpin_page(pool.pin_page(i));
+                        }
+                        size_t const miss = pool.stat().miss;
+                        SDL_ASSERT(page_test_file::check_page(pool.load_page(1), 1));
+                        SDL_ASSERT(pool.stat().miss == miss + 1);
+                        SDL_ASSERT(pool.load_page(0) == resident);
+                    }
+                    if (1) { // extent read with one request gives the same pages as reads by page
+                        page_pool pool(file.name(), 8);
+                        page_pool single(file.name(), 8);
+                        SDL_ASSERT(pool.load_extent(2, 8) == 4); // read ahead takes at most half of the pool
+                        SDL_ASSERT((pool.stat().batch_reads == 1) && (pool.stat().miss == 4));
+                        for (size_t i = 2; i < 6; ++i) {
+                            page_head const * const p = pool.load_page(i);
+                            SDL_ASSERT(page_test_file::check_page(p, i));
+                            SDL_ASSERT(!memcmp(p, single.load_page(i), page_head::page_size));
+                        }
+                        SDL_ASSERT((pool.stat().hit == 4) && (pool.stat().miss == 4));
+                        SDL_ASSERT(!pool.load_extent(3, 2)); // pages are in pool
+                        SDL_ASSERT(pool.load_extent(5, 4) == 3); // missing pages 6..8 are one request
+                        SDL_ASSERT(pool.stat().batch_reads == 2);
+                        for (size_t i = 6; i < 9; ++i) {
+                            SDL_ASSERT(!memcmp(pool.load_page(i), single.load_page(i), page_head::page_size));
+                        }
+                        SDL_ASSERT((pool.stat().hit == 7) && !pool.stat().evicted);
+                    }
+                    if (1) { // extent read into exhausted pool does not leave frames loading
+                        page_pool pool(file.name(), 4);
+                        page_head const * pinned[3];
+                        for (size_t i = 0; i < 3; ++i) {
+                            pinned[i] = pool.pin_page(i);
+                        }
+                        SDL_ASSERT(pool.load_extent(5, 2) == 1); // one frame is free
+                        SDL_ASSERT(page_test_file::check_page(pool.load_page(5), 5));
+                        SDL_ASSERT(!pool.load_extent(7, 2)); // no frame is free
+                        SDL_ASSERT(pool.stat().batch_reads == 1);
+                        SDL_ASSERT((pool.stat().hit == 1) && (pool.stat().miss == 4));
+                        for (auto const p : pinned) {
+                            pool.unpin_page(p);
+                        }
+                        SDL_ASSERT(page_test_file::check_page(pool.load_page(6), 6));
+                        SDL_ASSERT(page_test_file::check_page(pool.load_page(7), 7));
+                        SDL_ASSERT((pool.stat().miss == 6) && (pool.stat().evicted == 2));
+                    }
+                }
+            };
+            static unit_test s_test;
+        }
+    } // db
+} // sdl
+#endif //#if SV_DEBUG
@@ -0,0 +1,86 @@
+// page_pool.h
+//
+#pragma once
+#ifndef __SDL_SYSTEM_PAGE_POOL_H__
+#define __SDL_SYSTEM_PAGE_POOL_H__
+
+#include "page_head.h"
+#include "filesys/file_read.h"
+#include <mutex>
+#include <condition_variable>
+
+namespace sdl { namespace db {
+
+// Fixed-size pool of 8 KB frames filled with positional reads, CLOCK eviction.
+// load_page, load_resident: frame stays until pool is destroyed; records, rows and index descents
+// keep raw pointers into frames without pins, so load_page frames stay resident until a pin-aware API exists;
+// pin_page: frame is stable until unpin_page, then it can be evicted;
+// load_extent: read ahead frames can be evicted until load_page takes them.
+class page_pool : noncopyable {
+    using page_pool_error = sdl_exception_t<page_pool>;
+    enum { page_size = page_head::page_size };
+public:
+    struct stat_type {
+        size_t hit = 0;
+        size_t miss = 0;
+        size_t evicted = 0;
+        size_t resident = 0; // frames kept by load_page or load_resident
+        size_t pinned = 0;
+        size_t frames = 0;
+        size_t batch_reads = 0; // read requests issued by load_extent
+    };
+    page_pool(const std::string & fname, size_t frame_count);
+    ~page_pool();
+
+    uint64 filesize() const {
+        return m_file.GetFileSize();
+    }
+    size_t page_count() const {
+        return m_table.size();
+    }
+    page_head const * load_page(size_t);
+    page_head const * load_resident(size_t);
+    page_head const * pin_page(size_t);
+    page_head const * pin_loaded(size_t); // pin page returned by load_page, not counted as hit
+    size_t load_extent(size_t first, size_t count); // read missing pages of range with batched reads, returns pages read
+    void unpin_page(page_head const *);
+    uint64 memory_offset(void const *) const; // file offset of address inside a frame
+    bool contains(void const * p) const {
+        return frame_index(p) < m_frameCount;
+    }
+    stat_type stat() const;
+private:
+    enum : uint32 { none = uint32(-1) };
+    enum class fetch_mode { resident, pin, repin };
+    struct frame_t {
+        uint32 page = none;
+        uint32 pin = 0;
+        bool ref = false;       // CLOCK reference bit
+        bool resident = false;  // returned by load_resident
+        bool loading = false;
+    };
+    page_head const * fetch(size_t, fetch_mode);
+    void keep(frame_t &, fetch_mode);
+    size_t find_victim();
+    size_t try_victim(); // m_frameCount if all frames are kept
+    size_t frame_index(void const *) const;
+    char * frame_data(size_t const f) const {
+        return m_data.get() + f * page_size;
+    }
+private:
+    FileReader m_file;
+    const size_t m_frameCount;
+    std::unique_ptr<char[]> m_data;
+    std::vector<frame_t> m_frame;
+    std::vector<uint32> m_table; // page => frame
+    size_t m_used = 0;
+    size_t m_hand = 0;
+    stat_type m_stat;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+};
+
+} // db
+} // sdl
+
+#endif // __SDL_SYSTEM_PAGE_POOL_H__
@@ -0,0 +1,228 @@
+// page_prefetch.cpp
+//
+#include "common/common.h"
+#include "page_prefetch.h"
+#include "page_test_file.h"
+#include <algorithm>
+#include <functional>
+
+namespace sdl { namespace db {
+
+page_prefetch::page_prefetch(PageMapping const & pm, size_t const depth)
+    : m_pm(pm)
+    , m_depth(depth)
+{
+    SDL_ASSERT(m_depth);
+    m_thread = std::thread(&page_prefetch::run, this);
+}
+
+page_prefetch::~page_prefetch()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+        m_stat.wasted += m_ahead.size();
+        m_ahead.clear();
+    }
+    m_cv.notify_one();
+    m_thread.join();
+}
+
+page_prefetch::stat_type
+page_prefetch::stat() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stat;
+}
+
+// must be called under lock
+void page_prefetch::consume(page_head const * const p)
+{
+    auto const found = std::find(m_ahead.begin(), m_ahead.end(), p);
+    if (found != m_ahead.end()) {
+        ++m_stat.hit;
+        m_stat.wasted += std::distance(m_ahead.begin(), found); // skipped by consumer
+        m_ahead.erase(m_ahead.begin(), found + 1);
+    }
+}
+
+void page_prefetch::restart(page_head const * const p,
+                            shared_page_runs const & runs,
+                            size_t const run)
+{
+    m_stat.wasted += m_ahead.size();
+    m_ahead.clear();
+    m_tail = p;
+    m_runs = runs; // previous runs are released here, under lock
+    m_run = run;
+    m_heap_id = runs ? p->data.pageId : pageFileID{};
+    ++m_gen;
+}
+
+void page_prefetch::next_page(page_head const * const p)
+{
+    if (p) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_runs || ((p != m_tail) && (std::find(m_ahead.begin(), m_ahead.end(), p) == m_ahead.end()))) {
+                restart(p, {}, 0); // new stream
+            }
+            else {
+                consume(p);
+            }
+        }
+        m_cv.notify_one();
+    }
+}
+
+void page_prefetch::heap_page(page_head const * const p, shared_page_runs const & runs, size_t const run)
+{
+    if (p && runs && (run < runs->size())) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if ((m_runs == runs) && !(m_heap_id < p->data.pageId)) {
+                consume(p);
+            }
+            else {
+                restart(p, runs, run); // new stream
+            }
+        }
+        m_cv.notify_one();
+    }
+}
+
+page_head const * page_prefetch::load_ahead(page_head const * const p) const
+{
+    try {
+        return m_pm.load_page(p->data.nextPage);
+    }
+    catch (sdl_exception &) {
+        SDL_ASSERT(0);
+    }
+    return nullptr;
+}
+
+page_head const * page_prefetch::load_heap(pageFileID const & id) const
+{
+    try {
+        return m_pm.load_page(id);
+    }
+    catch (sdl_exception &) {
+        SDL_ASSERT(0);
+    }
+    return nullptr;
+}
+
+void page_prefetch::run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+        m_cv.wait(lock, [this](){
+            return m_stop || (m_tail && (m_ahead.size() < m_depth));
+        });
+        if (m_stop) {
+            break;
+        }
+        size_t const gen = m_gen;
+        page_head const * const tail = m_tail;
+        page_head const * next = nullptr;
+        if (m_runs) { // next page of runs, page type is not checked
+            std::vector<page_run> const & runs = *m_runs;
+            pageFileID id = m_heap_id;
+            if (id.pageId + 1 < runs[m_run].first.pageId + runs[m_run].count) {
+                ++id.pageId;
+            }
+            else if (m_run + 1 < runs.size()) {
+                id = runs[++m_run].first;
+            }
+            else {
+                id = {};
+            }
+            if (id) {
+                m_heap_id = id;
+                lock.unlock();
+                next = load_heap(id); // buffer pool reads page here
+                lock.lock();
+                if (gen != m_gen) {
+                    continue;
+                }
+            }
+        }
+        else {
+            lock.unlock();
+            next = load_ahead(tail); // reads tail header, fault is taken here
+            lock.lock();
+            if (gen != m_gen) {
+                continue;
+            }
+        }
+        if (!next) {
+            m_tail = nullptr; // end of stream
+            continue;
+        }
+        lock.unlock();
+        PageMapping::touch_page(next);
+        lock.lock();
+        if (gen == m_gen) {
+            m_tail = next;
+            m_ahead.push_back(next);
+            ++m_stat.fetched;
+        }
+    }
+}
+
+} // db
+} // sdl
+
+#if SDL_DEBUG
+namespace sdl {
+    namespace db {
+        namespace {
+            class unit_test {
+            public:
+                unit_test()
+                {
+                    SDL_TRACE_FILE;
+                    page_test_file const file("prefetch", 16);
+                    PageMapping const pm(file.name());
+                    auto const wait_for = [](std::function<bool()> const & fun) {
+                        for (size_t i = 0; (i < 2000) && !fun(); ++i) {
+                            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                        }
+                        return fun();
+                    };
+                    auto const page = [&pm](size_t const i) {
+                        return pm.load_page(page_test_file::make_id(i));
+                    };
+                    if (1) { // nextPage chain
+                        page_prefetch test(pm, 4);
+                        test.next_page(page(1));
+                        SDL_ASSERT(wait_for([&test](){ return test.stat().fetched == 4; })); // pages 2..5
+                        for (size_t i = 2; i < 6; ++i) {
+                            test.next_page(page(i));
+                        }
+                        SDL_ASSERT(test.stat().hit == 4);
+                        SDL_ASSERT(wait_for([&test](){ return test.stat().fetched == 8; })); // depth is refilled
+                        test.next_page(page(1)); // not in stream, restart
+                        SDL_ASSERT(test.stat().wasted == 4);
+                    }
+                    if (1) { // heap runs outlive cache entry of caller
+                        auto runs = std::make_shared<std::vector<page_run>>();
+                        runs->push_back({ page_test_file::make_id(1), 3 });  // 1..3
+                        runs->push_back({ page_test_file::make_id(10), 3 }); // 10..12
+                        std::weak_ptr<std::vector<page_run> const> const weak = runs;
+                        page_prefetch test(pm, 4);
+                        test.heap_page(page(1), runs, 0);
+                        runs.reset(); // evicted by database cache
+                        SDL_ASSERT(!weak.expired());
+                        SDL_ASSERT(wait_for([&test](){ return test.stat().fetched == 4; })); // 2, 3, 10, 11
+                        test.next_page(page(5)); // new stream releases runs
+                        SDL_ASSERT(weak.expired());
+                    }
+                }
+            };
+            static unit_test s_test;
+        }
+    } // db
+} // sdl
+#endif //#if SV_DEBUG
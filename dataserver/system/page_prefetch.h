@@ -0,0 +1,65 @@
+// page_prefetch.h
+//
+#pragma once
+#ifndef __SDL_SYSTEM_PAGE_PREFETCH_H__
+#define __SDL_SYSTEM_PAGE_PREFETCH_H__
+
+#include "page_map.h"
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <deque>
+
+namespace sdl { namespace db {
+
+// Background thread that touches pages ahead of the scan position,
+// so page faults are taken by the prefetch thread instead of the consumer.
+// Follows one stream: the most recent nextPage chain or heap page runs.
+class page_prefetch : noncopyable {
+public:
+    using shared_page_runs = std::shared_ptr<std::vector<page_run> const>;
+    struct stat_type {
+        size_t fetched = 0; // pages touched by prefetch thread
+        size_t hit = 0;     // pages reached by consumer after prefetch
+        size_t wasted = 0;  // prefetched pages skipped or abandoned by consumer
+    };
+    page_prefetch(PageMapping const &, size_t depth);
+    ~page_prefetch();
+
+    size_t depth() const {
+        return m_depth;
+    }
+    // consumer moved to page p of nextPage chain
+    void next_page(page_head const * p);
+
+    // consumer moved to page p of heap page runs, p belongs to (*runs)[run];
+    // runs are held by prefetch thread while it follows them
+    void heap_page(page_head const * p, shared_page_runs const & runs, size_t run);
+
+    stat_type stat() const;
+private:
+    void consume(page_head const *);
+    void restart(page_head const *, shared_page_runs const & runs, size_t run);
+    void run();
+    page_head const * load_ahead(page_head const *) const;
+    page_head const * load_heap(pageFileID const &) const;
+private:
+    PageMapping const & m_pm;
+    const size_t m_depth;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<page_head const *> m_ahead; // prefetched pages in scan order
+    page_head const * m_tail = nullptr;    // last page known to stream
+    shared_page_runs m_runs; // heap mode if not empty
+    size_t m_run = 0; // heap mode: run of m_tail
+    pageFileID m_heap_id{}; // heap mode: page of m_tail
+    size_t m_gen = 0; // stream generation
+    bool m_stop = false;
+    stat_type m_stat;
+    std::thread m_thread;
+};
+
+} // db
+} // sdl
+
+#endif // __SDL_SYSTEM_PAGE_PREFETCH_H__
@@ -0,0 +1,87 @@
+// page_test_file.h
+//
+#pragma once
+#ifndef __SDL_SYSTEM_PAGE_TEST_FILE_H__
+#define __SDL_SYSTEM_PAGE_TEST_FILE_H__
+
+#if SDL_DEBUG
+
+#include "page_head.h"
+#include <fstream>
+#include <cstdio>
+#include <chrono>
+
+namespace sdl { namespace db {
+
+// Data file of synthetic pages for unit tests, removed by destructor.
+// Page 0 is file header, pages [1, page_count) are data pages linked by nextPage/prevPage;
+// page body is filled with byte of page number, so page content can be checked.
+class page_test_file : noncopyable {
+public:
+    page_test_file(const char * const tag, size_t const page_count, uint16 const fileId = 1)
+        : m_name(make_name(tag))
+        , m_page_count(page_count)
+    {
+        SDL_ASSERT(page_count > 1);
+        std::ofstream out(m_name, std::ofstream::out | std::ofstream::trunc | std::ofstream::binary);
+        std::vector<char> buf(page_head::page_size);
+        for (size_t i = 0; i < page_count; ++i) {
+            std::fill(buf.begin(), buf.end(), static_cast<char>(i));
+            page_head & h = *reinterpret_cast<page_head *>(buf.data());
+            memset_zero(h);
+            h.data.pageId = make_id(i, fileId);
+            if (i) {
+                h.data.type = pageType::init(pageType::type::data);
+                if (i > 1) {
+                    h.data.prevPage = make_id(i - 1, fileId);
+                }
+                if (i + 1 < page_count) {
+                    h.data.nextPage = make_id(i + 1, fileId);
+                }
+            }
+            else {
+                h.data.type = pageType::init(pageType::type::fileheader);
+            }
+            out.write(buf.data(), buf.size());
+        }
+        SDL_ASSERT(out.good());
+    }
+    ~page_test_file() {
+        std::remove(m_name.c_str());
+    }
+    const std::string & name() const {
+        return m_name;
+    }
+    size_t page_count() const {
+        return m_page_count;
+    }
+    static pageFileID make_id(size_t const i, uint16 const fileId = 1) {
+        pageFileID id;
+        id.pageId = static_cast<uint32>(i);
+        id.fileId = fileId;
+        return id;
+    }
+    static bool check_page(page_head const * const h, size_t const i) { // header and body of page i
+        if (!h || (h->data.pageId.pageId != i)) {
+            return false;
+        }
+        char const * const p = page_head::begin(h);
+        return std::all_of(p + page_head::head_size, p + page_head::page_size, [i](char const c) {
+            return c == static_cast<char>(i);
+        });
+    }
+private:
+    static std::string make_name(const char * const tag) {
+        auto const ticks = std::chrono::steady_clock::now().time_since_epoch().count();
+        return std::string("sdl_test_") + tag + "_" + std::to_string(static_cast<long long>(ticks)) + ".tmp";
+    }
+private:
+    const std::string m_name;
+    const size_t m_page_count;
+};
+
+} // db
+} // sdl
+
+#endif // SDL_DEBUG
+#endif // __SDL_SYSTEM_PAGE_TEST_FILE_H__
@@ -414,6 +414,12 @@ struct recordID // 8 bytes
     }
 };
 
+struct page_run // 10 bytes : consecutive pages [first, first + count) of one data file
+{
+    pageFileID  first;      // 6 bytes
+    uint32      count;      // 4 bytes
+};
+
 struct pageLSN // 10 bytes
 {
     uint32 lsn1;
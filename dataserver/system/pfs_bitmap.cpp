@@ -0,0 +1,187 @@
+// pfs_bitmap.cpp
+//
+#include "common/common.h"
+#include "pfs_bitmap.h"
+
+namespace sdl { namespace db {
+
+namespace {
+
+// first page >= from with allocated bit equal to value; page_count if not found
+template<class vector_type>
+size_t find_next(vector_type const & bits, size_t const page_count, size_t const from, bool const value)
+{
+    enum { word_bits = 64 };
+    using word_type = typename vector_type::value_type;
+    size_t w = from / word_bits;
+    if (w >= bits.size()) {
+        return page_count;
+    }
+    word_type word = value ? bits[w] : ~bits[w];
+    word &= ~word_type(0) << (from % word_bits);
+    while (!word) {
+        if (++w == bits.size()) {
+            return page_count;
+        }
+        word = value ? bits[w] : ~bits[w];
+    }
+    size_t i = 0;
+    while (!((word >> i) & 1)) {
+        ++i;
+    }
+    return a_min(w * word_bits + i, page_count);
+}
+
+} // namespace
+
+pfs_bitmap::pfs_bitmap(file_page_count const & files)
+{
+    m_file.resize(files.size());
+    for (size_t i = 0; i < files.size(); ++i) {
+        file_type & f = m_file[i];
+        f.fileId = files[i].first;
+        f.page_count = files[i].second;
+        f.byte.resize(f.page_count);
+        f.bits.resize((f.page_count + word_bits - 1) / word_bits);
+        for (size_t first = 0; first < f.page_count; first += pfs_size) {
+            m_interval.push_back(pfs_page_for(f.fileId, first));
+        }
+    }
+}
+
+pageFileID pfs_bitmap::pfs_page_for(uint16 const fileId, size_t const first)
+{
+    SDL_ASSERT(!(first % pfs_size));
+    pageFileID id;
+    id.pageId = a_max(static_cast<uint32>(first), uint32(1)); // first PFS page is 1
+    id.fileId = fileId;
+    return id;
+}
+
+void pfs_bitmap::set_interval(size_t const i, pfs_page_row const * const row)
+{
+    SDL_ASSERT(row);
+    pageFileID const id = interval(i);
+    if (file_type * const f = const_cast<file_type *>(find(id.fileId))) {
+        size_t const first = id.pageId / pfs_size * pfs_size;
+        SDL_ASSERT(first < f->page_count);
+        size_t const count = a_min<size_t>(pfs_size, f->page_count - first);
+        std::copy(row->begin(), row->begin() + count, f->byte.begin() + first);
+    }
+    else {
+        SDL_ASSERT(0);
+    }
+}
+
+void pfs_bitmap::commit()
+{
+    for (auto & f : m_file) {
+        std::fill(f.bits.begin(), f.bits.end(), word_type(0));
+        for (size_t i = 0; i < f.page_count; ++i) {
+            if (f.byte[i].is_allocated()) {
+                f.bits[i / word_bits] |= word_type(1) << (i % word_bits);
+            }
+        }
+    }
+}
+
+pfs_byte pfs_bitmap::get(pageFileID const & id) const
+{
+    if (file_type const * const f = find(id.fileId)) {
+        if (id.pageId < f->page_count) {
+            return f->byte[id.pageId];
+        }
+    }
+    return {};
+}
+
+size_t pfs_bitmap::allocated_count() const
+{
+    size_t result = 0;
+    for (auto const & f : m_file) {
+        for (word_type w : f.bits) {
+            while (w) {
+                w &= w - 1;
+                ++result;
+            }
+        }
+    }
+    return result;
+}
+
+size_t pfs_bitmap::memory_size() const
+{
+    size_t result = m_file.capacity() * sizeof(file_type) + m_interval.capacity() * sizeof(pageFileID);
+    for (auto const & f : m_file) {
+        result += f.byte.capacity() * sizeof(pfs_byte) + f.bits.capacity() * sizeof(word_type);
+    }
+    return result;
+}
+
+pfs_bitmap::vector_range
+pfs_bitmap::allocated_ranges() const
+{
+    vector_range result;
+    for (auto const & f : m_file) {
+        size_t first = find_next(f.bits, f.page_count, 0, true);
+        while (first < f.page_count) {
+            size_t const last = find_next(f.bits, f.page_count, first, false);
+            pageFileID id;
+            id.pageId = static_cast<uint32>(first);
+            id.fileId = f.fileId;
+            result.emplace_back(id, last - first);
+            first = find_next(f.bits, f.page_count, last, true);
+        }
+    }
+    return result;
+}
+
+} // db
+} // sdl
+
+#if SDL_DEBUG
+namespace sdl {
+    namespace db {
+        namespace {
+            class unit_test {
+            public:
+                unit_test()
+                {
+                    SDL_TRACE_FILE;
+                    enum { page_count = pfs_bitmap::pfs_size + 100 };
+                    pfs_bitmap test({ { uint16(1), size_t(page_count) } });
+                    SDL_ASSERT(test.interval_count() == 2);
+                    SDL_ASSERT(test.interval(0).pageId == 1);
+                    SDL_ASSERT(test.interval(1).pageId == pfs_bitmap::pfs_size);
+                    pfs_page_row row;
+                    memset_zero(row);
+                    for (size_t i = 60; i < 70; ++i) {
+                        row.data.body[i].b.allocated = 1;
+                    }
+                    row.data.body[pfs_bitmap::pfs_size - 1].b.allocated = 1;
+                    test.set_interval(0, &row);
+                    test.set_interval(1, &row);
+                    test.commit();
+                    pageFileID id;
+                    id.fileId = 1;
+                    id.pageId = 59; SDL_ASSERT(!test.is_allocated(id));
+                    id.pageId = 60; SDL_ASSERT(test.is_allocated(id));
+                    id.pageId = 69; SDL_ASSERT(test.is_allocated(id));
+                    id.pageId = 70; SDL_ASSERT(!test.is_allocated(id));
+                    id.pageId = page_count; SDL_ASSERT(!test.is_allocated(id));
+                    SDL_ASSERT(test.allocated_count() == 21);
+                    auto const ranges = test.allocated_ranges();
+                    SDL_ASSERT(ranges.size() == 3);
+                    SDL_ASSERT(ranges[0].first.pageId == 60);
+                    SDL_ASSERT(ranges[0].second == 10);
+                    SDL_ASSERT(ranges[1].first.pageId == pfs_bitmap::pfs_size - 1);
+                    SDL_ASSERT(ranges[1].second == 1);
+                    SDL_ASSERT(ranges[2].first.pageId == pfs_bitmap::pfs_size + 60);
+                    SDL_ASSERT(ranges[2].second == 10);
+                }
+            };
+            static unit_test s_test;
+        }
+    } // db
+} // sdl
+#endif //#if SV_DEBUG
@@ -0,0 +1,82 @@
+// pfs_bitmap.h
+//
+#pragma once
+#ifndef __SDL_SYSTEM_PFS_BITMAP_H__
+#define __SDL_SYSTEM_PFS_BITMAP_H__
+
+#include "sysobj/pfs_page.h"
+
+namespace sdl { namespace db {
+
+// Allocation state of every page of the database decoded from PFS pages once at open.
+// Every PFS page describes an interval of pfs_size pages; intervals are independent
+// and can be set from several threads, then commit() packs allocated bits.
+// PFS byte (page type, fullness) is kept per page for full-file utilities.
+class pfs_bitmap : noncopyable {
+    using word_type = uint64;
+    enum { word_bits = 64 };
+    struct file_type {
+        uint16 fileId = 0;
+        size_t page_count = 0;
+        std::vector<pfs_byte> byte;     // page => PFS byte
+        std::vector<word_type> bits;    // page => allocated bit
+    };
+public:
+    enum { pfs_size = pfs_page_row::pfs_size }; // = 8088
+    using file_page_count = std::vector<std::pair<uint16, size_t>>; // fileId, page count
+    using range_type = std::pair<pageFileID, size_t>; // first page, page count
+    using vector_range = std::vector<range_type>;
+
+    explicit pfs_bitmap(file_page_count const &);
+
+    size_t interval_count() const { // PFS pages of all data files
+        return m_interval.size();
+    }
+    pageFileID interval(size_t const i) const { // i-th PFS page
+        SDL_ASSERT(i < m_interval.size());
+        return m_interval[i];
+    }
+    void set_interval(size_t, pfs_page_row const *); // thread safe for different intervals
+    void commit(); // after all intervals are set
+
+    bool is_allocated(pageFileID const &) const;
+    pfs_byte get(pageFileID const &) const;
+    size_t allocated_count() const;
+    vector_range allocated_ranges() const; // runs of allocated pages, ordered by file and page
+    size_t memory_size() const; // approximate heap bytes
+private:
+    file_type const * find(uint16 fileId) const;
+    static pageFileID pfs_page_for(uint16 fileId, size_t first);
+private:
+    std::vector<file_type> m_file;
+    std::vector<pageFileID> m_interval;
+};
+
+inline pfs_bitmap::file_type const *
+pfs_bitmap::find(uint16 const fileId) const
+{
+    if (m_file.size() == 1) { // single file, fileId is not checked as in PageMapping
+        return &m_file[0];
+    }
+    for (auto const & f : m_file) {
+        if (f.fileId == fileId) {
+            return &f;
+        }
+    }
+    return nullptr;
+}
+
+inline bool pfs_bitmap::is_allocated(pageFileID const & id) const
+{
+    if (file_type const * const f = find(id.fileId)) {
+        if (id.pageId < f->page_count) {
+            return (f->bits[id.pageId / word_bits] >> (id.pageId % word_bits)) & 1;
+        }
+    }
+    return false;
+}
+
+} // db
+} // sdl
+
+#endif // __SDL_SYSTEM_PFS_BITMAP_H__
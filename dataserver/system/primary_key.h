@@ -111,6 +111,13 @@ public:
         SDL_ASSERT(i < size());
         return (sortorder::DESC == col_ord(i));
     }
+    bool is_integer_key() const { // single ascending int or bigint column, key is compared as integer
+        if ((size() == 1) && !is_descending(0)) {
+            scalartype::type const t = (*this)[0].type;
+            return (t == scalartype::t_int) || (t == scalartype::t_bigint);
+        }
+        return false;
+    }
     template<class fun_type>
     void for_column(fun_type && fun) const {
         for (size_t i = 0, end = size(); i < end; ++i) {